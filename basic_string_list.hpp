@@ -0,0 +1,767 @@
+#ifndef BASIC_STRING_LIST_HPP_
+#define BASIC_STRING_LIST_HPP_
+
+#include "string_list.hpp"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define STRING_LIST_HAS_PMR
+#include <memory_resource>
+#endif
+
+// Allocator policies provide allocate, reallocate and deallocate. Every call passes
+// the exact size of the block, so sized resources can be plugged in. They return
+// nullptr instead of throwing when they run out of memory.
+
+#ifdef STRING_LIST_COUNT_ALLOCATIONS
+// Number of allocate and reallocate calls of MallocAllocator so far, defined in
+// string_list.cpp. Every translation unit of the target has to see the same setting.
+extern SizeType string_list_allocation_count;
+#define STRING_LIST_COUNT_ALLOCATION() (++string_list_allocation_count)
+#else
+#define STRING_LIST_COUNT_ALLOCATION() ((void)0)
+#endif
+
+// The policy behind the C interface in string_list.cpp
+struct MallocAllocator
+{
+    void* allocate(SizeType bytes_count)
+    {
+        STRING_LIST_COUNT_ALLOCATION();
+        return malloc(bytes_count);
+    }
+
+    void* reallocate(void* block, SizeType, SizeType new_bytes_count)
+    {
+        STRING_LIST_COUNT_ALLOCATION();
+        return realloc(block, new_bytes_count);
+    }
+
+    void deallocate(void* block, SizeType)
+    {
+        free(block);
+    }
+};
+
+// Bump allocator over a caller owned buffer, for lists that die together with a request.
+// Nothing is reused before the whole buffer is discarded, except that the most recent
+// block can grow or shrink in place.
+class MonotonicAllocator
+{
+public:
+    MonotonicAllocator(void* buffer, SizeType buffer_size)
+        : buffer((CharType*)buffer), buffer_size(buffer_size), used_bytes(0u), last_block(nullptr)
+    {
+    }
+
+    void* allocate(SizeType bytes_count)
+    {
+        const SizeType alignment = sizeof(SizeType) << 1;
+        const SizeType misalignment = (SizeType)((uintptr_t)(buffer + used_bytes) % alignment);
+        const SizeType offset = used_bytes + (misalignment == 0u ? 0u : alignment - misalignment);
+
+        if (offset > buffer_size || bytes_count > buffer_size - offset)
+        {
+            return nullptr;
+        }
+
+        last_block = buffer + offset;
+        used_bytes = offset + bytes_count;
+
+        return last_block;
+    }
+
+    void* reallocate(void* block, SizeType old_bytes_count, SizeType new_bytes_count)
+    {
+        const SizeType block_offset = (CharType*)block - buffer;
+
+        if (block == last_block && new_bytes_count <= buffer_size - block_offset)
+        {
+            used_bytes = block_offset + new_bytes_count;
+            return block;
+        }
+
+        void* new_block = allocate(new_bytes_count);
+
+        if (new_block != nullptr)
+        {
+            memcpy(new_block, block, old_bytes_count < new_bytes_count ? old_bytes_count : new_bytes_count);
+        }
+
+        return new_block;
+    }
+
+    void deallocate(void*, SizeType)
+    {
+    }
+
+    SizeType get_used_bytes() const
+    {
+        return used_bytes;
+    }
+
+private:
+    CharType* buffer;
+    SizeType buffer_size;
+    SizeType used_bytes;
+    void* last_block;
+};
+
+#ifdef STRING_LIST_HAS_PMR
+
+// Adapter for std::pmr resources; the resource is reached through its virtual interface
+class PmrAllocator
+{
+public:
+    explicit PmrAllocator(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource(resource)
+    {
+    }
+
+    void* allocate(SizeType bytes_count)
+    {
+        try
+        {
+            return resource->allocate(bytes_count, ALIGNMENT);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void* reallocate(void* block, SizeType old_bytes_count, SizeType new_bytes_count)
+    {
+        void* new_block = allocate(new_bytes_count);
+
+        if (new_block != nullptr)
+        {
+            memcpy(new_block, block, old_bytes_count < new_bytes_count ? old_bytes_count : new_bytes_count);
+            resource->deallocate(block, old_bytes_count, ALIGNMENT);
+        }
+
+        return new_block;
+    }
+
+    void deallocate(void* block, SizeType bytes_count)
+    {
+        resource->deallocate(block, bytes_count, ALIGNMENT);
+    }
+
+private:
+    static const SizeType ALIGNMENT = sizeof(SizeType) << 1;
+
+    std::pmr::memory_resource* resource;
+};
+
+#endif // STRING_LIST_HAS_PMR
+
+// Memory layout shared by the C interface and BasicStringList. The pointer array is
+// preceded by the size and the capacity of the list. Every payload is preceded by
+// its reference count and its owner: either the arena it was packed into, or its own
+// allocation size shifted left and tagged with the lowest bit.
+namespace string_list_detail
+{
+
+static const SizeType INITIAL_CAPACITY = 0u;
+static const SizeType FIELDS_BLOCK_SIZE = sizeof(SizeType) << 1;
+static const SizeType ELEMENT_HEADER_SIZE = sizeof(SizeType) << 1;
+static const SizeType ARENA_HEADER_SIZE = sizeof(SizeType) << 1;
+static const SizeType OWN_ALLOCATION_TAG = 1u;
+
+inline size_t allocating_bytes_count(const SizeType capacity)
+{
+    return capacity * sizeof(mString) + FIELDS_BLOCK_SIZE;
+}
+
+inline void move_to_the_fields_block(StringList* list_ptr)
+{
+    StringList list = *list_ptr;
+    SizeType* reinterpreted_list = (SizeType*)list;
+    reinterpreted_list -= 2;
+    *list_ptr = (StringList)reinterpreted_list;
+}
+
+inline void move_to_the_strings_block(StringList* list_ptr)
+{
+    StringList list = *list_ptr;
+    SizeType* reinterpreted_list = (SizeType*)list;
+    reinterpreted_list += 2;
+    *list_ptr = (StringList)reinterpreted_list;
+}
+
+inline void set_fields_block(StringList list)
+{
+    const SizeType initial_size = 0u;
+    SizeType* fields_view = (SizeType*)list;
+    fields_view[0] = initial_size;
+    fields_view[1] = INITIAL_CAPACITY;
+}
+
+inline SizeType* get_size_ptr(StringList list)
+{
+    move_to_the_fields_block(&list);
+    return (SizeType*)list;
+}
+
+inline SizeType* get_capacity_ptr(StringList list)
+{
+    move_to_the_fields_block(&list);
+    return (SizeType*)list + 1;
+}
+
+inline SizeType string_list_capacity(StringList list)
+{
+    return *get_capacity_ptr(list);
+}
+
+inline SizeType next_capacity(const SizeType old_capacity)
+{
+    return 1 + (old_capacity << 1);
+}
+
+inline SizeType* get_reference_count_ptr(cString element)
+{
+    return (SizeType*)(element - ELEMENT_HEADER_SIZE);
+}
+
+// Payload and arena counts are shared by lists that may live on different threads
+inline SizeType load_count(const SizeType* count)
+{
+#if defined(_MSC_VER)
+    return *(const volatile SizeType*)count;
+#else
+    return __atomic_load_n(count, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline void increment_count(SizeType* count)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    _InterlockedIncrement64((volatile __int64*)count);
+#elif defined(_MSC_VER)
+    _InterlockedIncrement((volatile long*)count);
+#else
+    __atomic_add_fetch(count, 1u, __ATOMIC_RELAXED);
+#endif
+}
+
+// Returns the count after the decrement
+inline SizeType decrement_count(SizeType* count)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    return (SizeType)_InterlockedDecrement64((volatile __int64*)count);
+#elif defined(_MSC_VER)
+    return (SizeType)_InterlockedDecrement((volatile long*)count);
+#else
+    return __atomic_sub_fetch(count, 1u, __ATOMIC_ACQ_REL);
+#endif
+}
+
+inline SizeType* get_owner_ptr(cString element)
+{
+    return get_reference_count_ptr(element) + 1;
+}
+
+// nullptr when the payload owns its allocation
+inline SizeType* element_arena(cString element)
+{
+    const SizeType owner = *get_owner_ptr(element);
+
+    return (owner & OWN_ALLOCATION_TAG) != 0u
+         ? nullptr
+         : (SizeType*)owner;
+}
+
+inline SizeType element_allocation_bytes(cString element)
+{
+    return *get_owner_ptr(element) >> 1;
+}
+
+inline void share_element(mString element)
+{
+    increment_count(get_reference_count_ptr(element));
+}
+
+template <class Allocator>
+ErrorCode init_string_list(StringList* list_ptr, Allocator& allocator)
+{
+    const size_t bytes_to_allocate_count = allocating_bytes_count(INITIAL_CAPACITY);
+    const bool size_type_overflow_detected = bytes_to_allocate_count < INITIAL_CAPACITY ||
+        bytes_to_allocate_count < FIELDS_BLOCK_SIZE;
+    if (size_type_overflow_detected)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    void* allocated_chunk = allocator.allocate(bytes_to_allocate_count);
+
+    if (allocated_chunk == nullptr)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    *list_ptr = (StringList)allocated_chunk;
+    set_fields_block(*list_ptr);
+    move_to_the_strings_block(list_ptr);
+
+    return ErrorCode::Success;
+}
+
+template <class Allocator>
+ErrorCode extend_string_list(StringList* list_ptr, const SizeType new_capacity, Allocator& allocator)
+{
+    const SizeType old_bytes_count = allocating_bytes_count(string_list_capacity(*list_ptr));
+    const SizeType realloc_bytes_count = allocating_bytes_count(new_capacity);
+    move_to_the_fields_block(list_ptr);
+    void* new_chunk = allocator.reallocate(*list_ptr, old_bytes_count, realloc_bytes_count);
+
+    if (new_chunk == nullptr)
+    {
+        move_to_the_strings_block(list_ptr);
+        return ErrorCode::LackOfMemory;
+    }
+
+    // reallocate preserves the contents and has already released the old chunk
+    *list_ptr = (StringList)new_chunk;
+    move_to_the_strings_block(list_ptr);
+
+    SizeType* capacity_ptr = get_capacity_ptr(*list_ptr);
+    *capacity_ptr = new_capacity;
+
+    return ErrorCode::Success;
+}
+
+template <class Allocator>
+mString allocate_element(const size_t bytes_count, Allocator& allocator)
+{
+    const SizeType allocation_bytes = ELEMENT_HEADER_SIZE + bytes_count;
+    void* allocated_memory = allocator.allocate(allocation_bytes);
+
+    if (allocated_memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    SizeType* header = (SizeType*)allocated_memory;
+    header[0] = 1u;
+    header[1] = (allocation_bytes << 1) | OWN_ALLOCATION_TAG;
+
+    return (mString)allocated_memory + ELEMENT_HEADER_SIZE;
+}
+
+template <class Allocator>
+ErrorCode place_element(StringList list, const SizeType index, cString str, Allocator& allocator)
+{
+    const size_t allocated_bytes_count = strlen(str) + 1;
+    mString allocated_memory = allocate_element(allocated_bytes_count, allocator);
+
+    if (allocated_memory == nullptr)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    list[index] = allocated_memory;
+    memcpy(list[index], str, allocated_bytes_count);
+
+    return ErrorCode::Success;
+}
+
+// An arena starts with the count of its live payloads and its size in bytes. The
+// creator holds one extra reference while it is filling the arena.
+template <class Allocator>
+SizeType* allocate_arena(const SizeType payload_bytes, Allocator& allocator)
+{
+    const SizeType arena_bytes = ARENA_HEADER_SIZE + payload_bytes;
+    SizeType* arena = (SizeType*)allocator.allocate(arena_bytes);
+
+    if (arena == nullptr)
+    {
+        return nullptr;
+    }
+
+    arena[0] = 1u;
+    arena[1] = arena_bytes;
+
+    return arena;
+}
+
+template <class Allocator>
+void release_arena_reference(SizeType* arena, Allocator& allocator)
+{
+    if (decrement_count(&arena[0]) == 0u)
+    {
+        allocator.deallocate(arena, arena[1]);
+    }
+}
+
+template <class Allocator>
+void release_element(mString element, Allocator& allocator)
+{
+    SizeType* reference_count_ptr = get_reference_count_ptr(element);
+
+    if (decrement_count(reference_count_ptr) != 0u)
+    {
+        return;
+    }
+
+    SizeType* arena = element_arena(element);
+
+    if (arena == nullptr)
+    {
+        allocator.deallocate(reference_count_ptr, element_allocation_bytes(element));
+    }
+    else
+    {
+        release_arena_reference(arena, allocator);
+    }
+}
+
+// Frees the pointer array only, the payloads are expected to be moved out or released already
+template <class Allocator>
+void release_pointer_block(StringList* list_ptr, Allocator& allocator)
+{
+    const SizeType bytes_count = allocating_bytes_count(string_list_capacity(*list_ptr));
+    move_to_the_fields_block(list_ptr);
+    allocator.deallocate(*list_ptr, bytes_count);
+    *list_ptr = nullptr;
+}
+
+template <class Allocator>
+ErrorCode destroy_string_list(StringList* list, Allocator& allocator)
+{
+    for (SizeType i = 0u; i < *get_size_ptr(*list); ++i)
+    {
+        release_element((*list)[i], allocator);
+    }
+
+    release_pointer_block(list, allocator);
+
+    return ErrorCode::Success;
+}
+
+template <class Allocator>
+ErrorCode add_string(StringList* list_ptr, cString str, Allocator& allocator)
+{
+    const SizeType size = *get_size_ptr(*list_ptr);
+    const SizeType capacity = string_list_capacity(*list_ptr);
+
+    if (size == capacity)
+    {
+        const SizeType new_capacity = next_capacity(capacity);
+        ErrorCode result_code = extend_string_list(list_ptr, new_capacity, allocator);
+
+        if (result_code != ErrorCode::Success)
+        {
+            return result_code;
+        }
+    }
+
+    ErrorCode result_code = place_element(*list_ptr, size, str, allocator);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    SizeType* size_ptr = get_size_ptr(*list_ptr);
+    ++(*size_ptr);
+
+    return ErrorCode::Success;
+}
+
+template <class Allocator>
+ErrorCode remove_string(StringList list, cString str, Allocator& allocator)
+{
+    StringList writing_ptr = list;
+    StringList reading_ptr = list;
+    StringList end_ptr = list + *get_size_ptr(list);
+    SizeType new_size = 0u;
+
+    for (; reading_ptr != end_ptr; ++reading_ptr)
+    {
+        mString read_word = *reading_ptr;
+
+        if (strcmp(read_word, str) != 0)
+        {
+            *writing_ptr = *reading_ptr;
+            ++writing_ptr;
+            ++new_size;
+        }
+        else
+        {
+            release_element(read_word, allocator);
+        }
+    }
+
+    SizeType* size_ptr = get_size_ptr(list);
+    *size_ptr = new_size;
+
+    return ErrorCode::Success;
+}
+
+// In place, so after must not be longer than before
+inline void replace_in_string(mString string, cString before, cString after)
+{
+    const SizeType string_len = strlen(string);
+    const SizeType before_len = strlen(before);
+    const SizeType after_len = strlen(after);
+
+    if (before_len == 0u || string_len < before_len)
+    {
+        return;
+    }
+
+    for (SizeType i = 0; i <= string_len - before_len; ++i)
+    {
+        if (strncmp(string + i, before, before_len) == 0)
+        {
+            memmove(string + i + after_len, string + i + before_len, string_len - i - before_len + 1);
+            memcpy(string + i, after, after_len);
+            i += after_len - 1;
+        }
+    }
+}
+
+// Replaces a shared payload with a private copy before it is modified in place
+template <class Allocator>
+ErrorCode detach_element(StringList list, const SizeType index, Allocator& allocator)
+{
+    mString shared_element = list[index];
+    ErrorCode result_code = place_element(list, index, shared_element, allocator);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    release_element(shared_element, allocator);
+
+    return ErrorCode::Success;
+}
+
+template <class Allocator>
+ErrorCode replace_in_strings(StringList list, cString before, cString after, Allocator& allocator)
+{
+    // An empty pattern matches every string but changes none, so nothing may be detached
+    if (*before == '\0')
+    {
+        return ErrorCode::Success;
+    }
+
+    for (SizeType i = 0u; i < *get_size_ptr(list); ++i)
+    {
+        if (load_count(get_reference_count_ptr(list[i])) > 1u && strstr(list[i], before) != nullptr)
+        {
+            ErrorCode result_code = detach_element(list, i, allocator);
+
+            if (result_code != ErrorCode::Success)
+            {
+                return result_code;
+            }
+        }
+
+        replace_in_string(list[i], before, after);
+    }
+
+    return ErrorCode::Success;
+}
+
+// Keeps the first occurrence of every string in place and releases the others
+template <class Allocator>
+ErrorCode remove_duplicates(StringList list, Allocator& allocator)
+{
+    const SizeType size = *get_size_ptr(list);
+    SizeType new_size = 0u;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        mString read_word = list[i];
+        SizeType kept_index = 0u;
+
+        while (kept_index < new_size && strcmp(list[kept_index], read_word) != 0)
+        {
+            ++kept_index;
+        }
+
+        if (kept_index == new_size)
+        {
+            list[new_size] = read_word;
+            ++new_size;
+        }
+        else
+        {
+            release_element(read_word, allocator);
+        }
+    }
+
+    SizeType* size_ptr = get_size_ptr(list);
+    *size_ptr = new_size;
+
+    return ErrorCode::Success;
+}
+
+} // namespace string_list_detail
+
+// StringList whose pointer array and payloads come from AllocatorPolicy. The policy is
+// stored as an empty base, so a stateless one costs nothing and its calls are inlined.
+// Operations that allocate or release list memory are members using the policy, the
+// others forward to the string_list_* functions. The underlying StringList is not
+// handed out, because the C interface releases memory with free; data() gives
+// read-only access to the strings instead.
+template <class AllocatorPolicy = MallocAllocator>
+class BasicStringList : private AllocatorPolicy
+{
+public:
+    explicit BasicStringList(const AllocatorPolicy& allocator = AllocatorPolicy())
+        : AllocatorPolicy(allocator), list(nullptr)
+    {
+    }
+
+    BasicStringList(BasicStringList&& other)
+        : AllocatorPolicy(std::move(other.get_allocator())), list(other.list)
+    {
+        other.list = nullptr;
+    }
+
+    BasicStringList(const BasicStringList&) = delete;
+    BasicStringList& operator=(const BasicStringList&) = delete;
+
+    ~BasicStringList()
+    {
+        destroy();
+    }
+
+    ErrorCode init()
+    {
+        if (list != nullptr)
+        {
+            return ErrorCode::Success;
+        }
+
+        return string_list_detail::init_string_list(&list, get_allocator());
+    }
+
+    ErrorCode destroy()
+    {
+        if (list == nullptr)
+        {
+            return ErrorCode::Success;
+        }
+
+        return string_list_detail::destroy_string_list(&list, get_allocator());
+    }
+
+    ErrorCode add(cString str)
+    {
+        if (list == nullptr || str == nullptr)
+        {
+            return ErrorCode::NullPointerInput;
+        }
+
+        return string_list_detail::add_string(&list, str, get_allocator());
+    }
+
+    ErrorCode remove(cString str)
+    {
+        if (list == nullptr || str == nullptr)
+        {
+            return ErrorCode::NullPointerInput;
+        }
+
+        return string_list_detail::remove_string(list, str, get_allocator());
+    }
+
+    ErrorCode replace_in_strings(cString before, cString after)
+    {
+        if (list == nullptr || before == nullptr || after == nullptr)
+        {
+            return ErrorCode::NullPointerInput;
+        }
+
+        return string_list_detail::replace_in_strings(list, before, after, get_allocator());
+    }
+
+    ErrorCode remove_duplicates()
+    {
+        if (list == nullptr)
+        {
+            return ErrorCode::NullPointerInput;
+        }
+
+        return string_list_detail::remove_duplicates(list, get_allocator());
+    }
+
+    ErrorCode index_of(cString str, SizeType* result) const
+    {
+        return string_list_index_of(list, str, result);
+    }
+
+    ErrorCode sort()
+    {
+        return string_list_sort(list);
+    }
+
+    ErrorCode partial_sort(const SizeType k)
+    {
+        return string_list_partial_sort(list, k);
+    }
+
+    ErrorCode partial_sort_descending(const SizeType k)
+    {
+        return string_list_partial_sort_descending(list, k);
+    }
+
+    ErrorCode nth_element(const SizeType n)
+    {
+        return string_list_nth_element(list, n);
+    }
+
+    ErrorCode sort_by(StringKeyFunction key_function)
+    {
+        return string_list_sort_by(list, key_function);
+    }
+
+    // The joined string is allocated with malloc and owned by the caller
+    ErrorCode join(cString separator, mString* result) const
+    {
+        return string_list_join(list, separator, result);
+    }
+
+    ErrorCode write_fd(int fd, cString separator) const
+    {
+        return string_list_write_fd(list, fd, separator);
+    }
+
+    SizeType size() const
+    {
+        return list == nullptr ? 0u : *string_list_detail::get_size_ptr(list);
+    }
+
+    cString operator[](const SizeType index) const
+    {
+        return list[index];
+    }
+
+    const cString* data() const
+    {
+        return list;
+    }
+
+    AllocatorPolicy& get_allocator()
+    {
+        return *this;
+    }
+
+private:
+    StringList list;
+};
+
+#endif // !BASIC_STRING_LIST_HPP_
@@ -0,0 +1,520 @@
+#include "compressed_string_list.hpp"
+#include "basic_string_list.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+#define PRIVATE static
+#define PUBLIC
+
+typedef unsigned char Byte;
+
+static MallocAllocator default_allocator;
+
+static const SizeType NO_CACHED_INDEX = (SizeType)(-1);
+static const Byte VARINT_CONTINUATION_BIT = 0x80u;
+static const Byte VARINT_PAYLOAD_MASK = 0x7Fu;
+
+struct CompressedStringListData
+{
+    SizeType size;
+    SizeType block_size;
+    SizeType block_count;
+    SizeType* block_offsets;
+    Byte* data;
+    SizeType data_bytes;
+
+    // The last decoded string and where the entry after it starts
+    mString cache;
+    SizeType cache_capacity;
+    SizeType cache_index;
+    SizeType cache_length;
+    SizeType cache_next_offset;
+};
+
+// Forwarded declarations of basic implementations
+ErrorCode impl_compressed_string_list_build(StringList sorted_list, const SizeType block_size, CompressedStringList* result);
+ErrorCode impl_compressed_string_list_destroy(CompressedStringList* list);
+SizeType impl_compressed_string_list_storage_bytes(CompressedStringList list);
+ErrorCode impl_compressed_string_list_get(CompressedStringList list, const SizeType index, mString buffer, const SizeType buffer_size, SizeType* length);
+SizeType impl_compressed_string_list_index_of(CompressedStringList list, cString str);
+
+// Forwarded declarations of utilities
+SizeType varint_bytes_count(SizeType value);
+Byte* write_varint(Byte* position, SizeType value);
+const Byte* read_varint(const Byte* position, SizeType* value);
+SizeType common_prefix_length(cString first, cString second);
+bool input_is_sorted(StringList list, const SizeType size);
+void decode_next_entry(CompressedStringList list);
+void seek_cached_entry(CompressedStringList list, const SizeType index);
+int compare_block_head(CompressedStringList list, const SizeType block, cString str, const SizeType str_length);
+
+// Validators forwarded declarations
+ErrorCode validate_input_compressed_list(CompressedStringList list);
+ErrorCode validate_input_compressed_list_ptr(CompressedStringList* list_ptr);
+ErrorCode validate_input_sorted_list(StringList list);
+ErrorCode validate_input_block_size(const SizeType block_size);
+ErrorCode validate_input_buffer(mString buffer);
+ErrorCode validate_input_size(SizeType* ptr);
+ErrorCode validate_input_str(cString str);
+
+// Validational decorators
+
+PUBLIC ErrorCode compressed_string_list_build(StringList sorted_list, SizeType block_size, CompressedStringList* result)
+{
+    ErrorCode list_validation_error = validate_input_sorted_list(sorted_list);
+    ErrorCode block_size_validation_error = validate_input_block_size(block_size);
+    ErrorCode result_validation_error = validate_input_compressed_list_ptr(result);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (result_validation_error != ErrorCode::Success)
+    {
+        return result_validation_error;
+    }
+
+    if (block_size_validation_error != ErrorCode::Success)
+    {
+        return block_size_validation_error;
+    }
+
+    return impl_compressed_string_list_build(sorted_list, block_size, result);
+}
+
+PUBLIC ErrorCode compressed_string_list_destroy(CompressedStringList* list)
+{
+    ErrorCode validation_error = validate_input_compressed_list_ptr(list);
+
+    if (validation_error != ErrorCode::Success)
+    {
+        return validation_error;
+    }
+
+    return impl_compressed_string_list_destroy(list);
+}
+
+PUBLIC ErrorCode compressed_string_list_size(CompressedStringList list, SizeType* result)
+{
+    ErrorCode list_validation_error = validate_input_compressed_list(list);
+    ErrorCode size_validation_error = validate_input_size(result);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (size_validation_error != ErrorCode::Success)
+    {
+        return size_validation_error;
+    }
+
+    *result = list->size;
+    return ErrorCode::Success;
+}
+
+PUBLIC ErrorCode compressed_string_list_storage_bytes(CompressedStringList list, SizeType* result)
+{
+    ErrorCode list_validation_error = validate_input_compressed_list(list);
+    ErrorCode size_validation_error = validate_input_size(result);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (size_validation_error != ErrorCode::Success)
+    {
+        return size_validation_error;
+    }
+
+    *result = impl_compressed_string_list_storage_bytes(list);
+    return ErrorCode::Success;
+}
+
+PUBLIC ErrorCode compressed_string_list_get(CompressedStringList list, SizeType index, mString buffer, SizeType buffer_size, SizeType* length)
+{
+    ErrorCode list_validation_error = validate_input_compressed_list(list);
+    ErrorCode buffer_validation_error = validate_input_buffer(buffer);
+    ErrorCode length_validation_error = validate_input_size(length);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (buffer_validation_error != ErrorCode::Success)
+    {
+        return buffer_validation_error;
+    }
+
+    if (length_validation_error != ErrorCode::Success)
+    {
+        return length_validation_error;
+    }
+
+    return impl_compressed_string_list_get(list, index, buffer, buffer_size, length);
+}
+
+PUBLIC ErrorCode compressed_string_list_index_of(CompressedStringList list, cString str, SizeType* result)
+{
+    ErrorCode list_validation_error = validate_input_compressed_list(list);
+    ErrorCode string_validation_error = validate_input_str(str);
+    ErrorCode index_validation_error = validate_input_size(result);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (string_validation_error != ErrorCode::Success)
+    {
+        return string_validation_error;
+    }
+
+    if (index_validation_error != ErrorCode::Success)
+    {
+        return index_validation_error;
+    }
+
+    *result = impl_compressed_string_list_index_of(list, str);
+
+    return ErrorCode::Success;
+}
+
+
+// Actual implementations
+
+// The first pass measures the encoding so that the data block is allocated once
+PRIVATE ErrorCode impl_compressed_string_list_build(StringList sorted_list, const SizeType block_size, CompressedStringList* result)
+{
+    SizeType size = 0u;
+    string_list_size(sorted_list, &size);
+
+    if (!input_is_sorted(sorted_list, size))
+    {
+        return ErrorCode::InvalidArgument;
+    }
+
+    SizeType data_bytes = 0u;
+    SizeType max_length = 0u;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        const SizeType length = strlen(sorted_list[i]);
+        const SizeType shared = i % block_size == 0u ? 0u : common_prefix_length(sorted_list[i - 1], sorted_list[i]);
+
+        if (i % block_size != 0u)
+        {
+            data_bytes += varint_bytes_count(shared);
+        }
+
+        data_bytes += varint_bytes_count(length - shared) + length - shared;
+        max_length = length > max_length ? length : max_length;
+    }
+
+    CompressedStringList list = (CompressedStringList)default_allocator.allocate(sizeof(CompressedStringListData));
+
+    if (list == nullptr)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    memset(list, 0, sizeof(CompressedStringListData));
+
+    list->size = size;
+    list->block_size = block_size;
+    list->block_count = (size + block_size - 1) / block_size;
+    list->block_offsets = (SizeType*)default_allocator.allocate(list->block_count * sizeof(SizeType) + 1);
+    list->data = (Byte*)default_allocator.allocate(data_bytes + 1);
+    list->data_bytes = data_bytes;
+    list->cache = (mString)default_allocator.allocate(max_length + 1);
+    list->cache_capacity = max_length + 1;
+    list->cache_index = NO_CACHED_INDEX;
+
+    if (list->block_offsets == nullptr || list->data == nullptr || list->cache == nullptr)
+    {
+        impl_compressed_string_list_destroy(&list);
+        return ErrorCode::LackOfMemory;
+    }
+
+    Byte* position = list->data;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        const SizeType length = strlen(sorted_list[i]);
+        SizeType shared = 0u;
+
+        if (i % block_size == 0u)
+        {
+            list->block_offsets[i / block_size] = position - list->data;
+        }
+        else
+        {
+            shared = common_prefix_length(sorted_list[i - 1], sorted_list[i]);
+            position = write_varint(position, shared);
+        }
+
+        position = write_varint(position, length - shared);
+        memcpy(position, sorted_list[i] + shared, length - shared);
+        position += length - shared;
+    }
+
+    *result = list;
+
+    return ErrorCode::Success;
+}
+
+PRIVATE ErrorCode impl_compressed_string_list_destroy(CompressedStringList* list)
+{
+    default_allocator.deallocate((*list)->block_offsets, (*list)->block_count * sizeof(SizeType) + 1);
+    default_allocator.deallocate((*list)->data, (*list)->data_bytes + 1);
+    default_allocator.deallocate((*list)->cache, (*list)->cache_capacity);
+    default_allocator.deallocate(*list, sizeof(CompressedStringListData));
+    *list = nullptr;
+
+    return ErrorCode::Success;
+}
+
+PRIVATE SizeType impl_compressed_string_list_storage_bytes(CompressedStringList list)
+{
+    return sizeof(CompressedStringListData) +
+        list->block_count * sizeof(SizeType) +
+        list->data_bytes +
+        list->cache_capacity;
+}
+
+PRIVATE ErrorCode impl_compressed_string_list_get(CompressedStringList list, const SizeType index, mString buffer, const SizeType buffer_size, SizeType* length)
+{
+    if (index >= list->size)
+    {
+        return ErrorCode::IndexOutOfRange;
+    }
+
+    seek_cached_entry(list, index);
+    *length = list->cache_length;
+
+    if (list->cache_length >= buffer_size)
+    {
+        return ErrorCode::BufferTooSmall;
+    }
+
+    memcpy(buffer, list->cache, list->cache_length + 1);
+
+    return ErrorCode::Success;
+}
+
+// Binary search over the block heads, then a forward scan from the last block whose
+// head is smaller than str; the scan may run into the next blocks on duplicates
+PRIVATE SizeType impl_compressed_string_list_index_of(CompressedStringList list, cString str)
+{
+    const SizeType str_length = strlen(str);
+    SizeType low = 0u;
+    SizeType high = list->block_count;
+
+    while (low < high)
+    {
+        const SizeType middle = low + (high - low) / 2;
+
+        if (compare_block_head(list, middle, str, str_length) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    const SizeType first_block = low == 0u ? 0u : low - 1;
+
+    for (SizeType i = first_block * list->block_size; i < list->size; ++i)
+    {
+        seek_cached_entry(list, i);
+        const int comparison = strcmp(list->cache, str);
+
+        if (comparison == 0)
+        {
+            return i;
+        }
+
+        if (comparison > 0)
+        {
+            break;
+        }
+    }
+
+    return (SizeType)(-1);
+}
+
+
+// Additional utilities
+
+PRIVATE SizeType varint_bytes_count(SizeType value)
+{
+    SizeType bytes_count = 1u;
+
+    for (value >>= 7; value != 0u; value >>= 7)
+    {
+        ++bytes_count;
+    }
+
+    return bytes_count;
+}
+
+PRIVATE Byte* write_varint(Byte* position, SizeType value)
+{
+    for (; value > VARINT_PAYLOAD_MASK; value >>= 7)
+    {
+        *position++ = (Byte)(value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUATION_BIT;
+    }
+
+    *position++ = (Byte)value;
+
+    return position;
+}
+
+PRIVATE const Byte* read_varint(const Byte* position, SizeType* value)
+{
+    SizeType result = 0u;
+    unsigned shift = 0u;
+
+    for (; (*position & VARINT_CONTINUATION_BIT) != 0u; ++position, shift += 7)
+    {
+        result |= (SizeType)(*position & VARINT_PAYLOAD_MASK) << shift;
+    }
+
+    *value = result | (SizeType)*position << shift;
+
+    return position + 1;
+}
+
+PRIVATE SizeType common_prefix_length(cString first, cString second)
+{
+    SizeType length = 0u;
+
+    while (first[length] != '\0' && first[length] == second[length])
+    {
+        ++length;
+    }
+
+    return length;
+}
+
+PRIVATE bool input_is_sorted(StringList list, const SizeType size)
+{
+    for (SizeType i = 1u; i < size; ++i)
+    {
+        if (strcmp(list[i - 1], list[i]) > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Decodes the entry after the cached one on top of it, reusing the shared prefix
+PRIVATE void decode_next_entry(CompressedStringList list)
+{
+    const SizeType index = list->cache_index + 1;
+    const Byte* position = list->data + list->cache_next_offset;
+    SizeType shared = 0u;
+    SizeType suffix_length = 0u;
+
+    if (index % list->block_size != 0u)
+    {
+        position = read_varint(position, &shared);
+    }
+
+    position = read_varint(position, &suffix_length);
+    memcpy(list->cache + shared, position, suffix_length);
+    list->cache[shared + suffix_length] = '\0';
+
+    list->cache_index = index;
+    list->cache_length = shared + suffix_length;
+    list->cache_next_offset = position + suffix_length - list->data;
+}
+
+PRIVATE void seek_cached_entry(CompressedStringList list, const SizeType index)
+{
+    const SizeType block = index / list->block_size;
+    const bool cache_is_usable = list->cache_index != NO_CACHED_INDEX &&
+        list->cache_index <= index &&
+        list->cache_index / list->block_size == block;
+
+    if (!cache_is_usable)
+    {
+        // Pretend the entry before the block head is cached, its contents are never read
+        list->cache_index = block * list->block_size - 1;
+        list->cache_next_offset = list->block_offsets[block];
+    }
+
+    while (list->cache_index != index)
+    {
+        decode_next_entry(list);
+    }
+}
+
+PRIVATE int compare_block_head(CompressedStringList list, const SizeType block, cString str, const SizeType str_length)
+{
+    SizeType head_length = 0u;
+    const Byte* head = read_varint(list->data + list->block_offsets[block], &head_length);
+    const SizeType common_length = head_length < str_length ? head_length : str_length;
+    const int comparison = memcmp(head, str, common_length);
+
+    if (comparison != 0 || head_length == str_length)
+    {
+        return comparison;
+    }
+
+    return head_length < str_length ? -1 : 1;
+}
+
+
+// Validators implementations
+
+PRIVATE inline ErrorCode validate_not_nullptr(const void* ptr)
+{
+    return ptr == nullptr
+         ? ErrorCode::NullPointerInput
+         : ErrorCode::Success;
+}
+
+PRIVATE inline ErrorCode validate_input_compressed_list(CompressedStringList list)
+{
+    return validate_not_nullptr(list);
+}
+
+PRIVATE inline ErrorCode validate_input_compressed_list_ptr(CompressedStringList* list_ptr)
+{
+    return validate_not_nullptr(list_ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_sorted_list(StringList list)
+{
+    return validate_not_nullptr(list);
+}
+
+PRIVATE inline ErrorCode validate_input_block_size(const SizeType block_size)
+{
+    return block_size < COMPRESSED_MIN_BLOCK_SIZE || block_size > COMPRESSED_MAX_BLOCK_SIZE
+         ? ErrorCode::InvalidArgument
+         : ErrorCode::Success;
+}
+
+PRIVATE inline ErrorCode validate_input_buffer(mString buffer)
+{
+    return validate_not_nullptr(buffer);
+}
+
+PRIVATE inline ErrorCode validate_input_size(SizeType* ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_str(cString str)
+{
+    return validate_not_nullptr(str);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef COMPRESSED_STRING_LIST_HPP_
+#define COMPRESSED_STRING_LIST_HPP_
+
+#include "string_list.hpp"
+
+// Read-only front coded copy of a sorted StringList. Strings are grouped into blocks:
+// the first string of a block is stored whole, every other one as the length of the
+// prefix it shares with its predecessor and the remaining suffix.
+//
+// get and index_of update a decode cache stored in the list, so they are not safe to
+// call on one list from several threads at once. Give every thread its own list or
+// serialise the calls.
+typedef struct CompressedStringListData* CompressedStringList;
+
+static const SizeType COMPRESSED_MIN_BLOCK_SIZE = 16u;
+static const SizeType COMPRESSED_MAX_BLOCK_SIZE = 64u;
+
+ErrorCode compressed_string_list_build(StringList sorted_list, SizeType block_size, CompressedStringList* result);
+ErrorCode compressed_string_list_destroy(CompressedStringList* list);
+
+ErrorCode compressed_string_list_size(CompressedStringList list, SizeType* result);
+ErrorCode compressed_string_list_storage_bytes(CompressedStringList list, SizeType* result);
+
+// Decodes the string at index into buffer. *length receives the string length
+// without the terminator, also when the buffer is too small to hold it. The last
+// decoded string is cached in the list, so scanning forward decodes every entry only once.
+ErrorCode compressed_string_list_get(CompressedStringList list, SizeType index, mString buffer, SizeType buffer_size, SizeType* length);
+ErrorCode compressed_string_list_index_of(CompressedStringList list, cString str, SizeType* result);
+
+#endif // !COMPRESSED_STRING_LIST_HPP_
@@ -1,12 +1,85 @@
 #include "string_list.hpp"
+#include "basic_string_list.hpp"
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include <io.h>
+#include <limits.h>
+#else
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_LIST_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define STRING_LIST_USE_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #define PRIVATE static
 #define PUBLIC
 
-static const SizeType INITIAL_CAPACITY = 0u;
-static const SizeType FIELDS_BLOCK_SIZE = sizeof(SizeType) << 1;
+using namespace string_list_detail;
+
+// All memory of the C interface goes through this policy, the buffers handed to the
+// caller included, so they can be released with free
+static MallocAllocator default_allocator;
+
+#ifdef STRING_LIST_COUNT_ALLOCATIONS
+SizeType string_list_allocation_count = 0u;
+#endif
+
+static const SizeType UNLIMITED_TIME_BUDGET = (SizeType)(-1);
+// One day, larger budgets would overflow the clock arithmetic
+static const unsigned long long MAX_TIME_BUDGET_US = 86400000000ull;
+static const SizeType COMPACTION_CLOCK_CHECK_INTERVAL = 64u;
+static const SizeType ESTIMATED_SORT_KEY_LENGTH = 16u;
+static const CharType NATURAL_KEY_NUMBER_MARKER = '0';
+static const SizeType NATURAL_KEY_LONG_NUMBER_LENGTH = 0xFFu;
+static const SizeType WRITE_BATCH_SIZE = 1024u;
+
+enum class SetOperation
+{
+    Union,
+    Intersection,
+    Difference,
+};
+
+// Open addressing set of borrowed strings, sized once for the expected number of
+// insertions so that it never has to grow while it is being filled.
+struct StringHashSet
+{
+    cString* slots;
+    SizeType mask;
+};
+
+// Distinct string and the number of its occurrences
+struct OccurrenceEntry
+{
+    SizeType count;
+    mString element;
+};
+
+// Sort key of an element, stored at offset in the shared keys buffer
+struct SortKeyEntry
+{
+    SizeType offset;
+    SizeType length;
+    mString element;
+};
 
 // Forwarded declarations of basic implementations
 ErrorCode impl_string_list_init(StringList* list_ptr);
@@ -19,19 +92,51 @@ SizeType impl_string_list_index_of(StringList list, cString str);
 ErrorCode impl_string_list_remove_duplicates(StringList* list);
 ErrorCode impl_string_list_replace_in_strings(StringList list, cString before, cString after);
 ErrorCode impl_string_list_sort(StringList list);
+ErrorCode impl_string_list_partial_sort(StringList list, SizeType k, const bool descending);
+ErrorCode impl_string_list_nth_element(StringList list, const SizeType n);
+ErrorCode impl_string_list_sort_by(StringList list, StringKeyFunction key_function);
+ErrorCode impl_string_list_join(StringList list, cString separator, mString* result);
+ErrorCode impl_string_list_write_fd(StringList list, const int fd, cString separator);
+ErrorCode impl_string_list_from_split(cString buffer, const SizeType length, const CharType delimiter, StringList* result);
+ErrorCode impl_string_list_set_operation(StringList* first, StringList* second, StringList* result, SetOperation operation);
+ErrorCode impl_string_list_clone(StringList list, StringList* result);
+ErrorCode impl_string_list_count_occurrences(StringList list, StringList* unique_list, SizeType** counts, const bool sort_by_count);
+ErrorCode impl_string_list_compact_step(StringList* list_ptr, StringListCompaction* compaction, const SizeType time_budget_us, SizeType* reclaimed_bytes, bool* finished);
+ErrorCode impl_string_list_compact_abort(StringListCompaction* compaction);
 
 // Forwarded declarations of utilities
-size_t allocating_bytes_count(const SizeType capacity);
-void move_to_the_fields_block(StringList* list_ptr);
-void move_to_the_strings_block(StringList* list_ptr);
-void set_fields_block(StringList list);
-SizeType* get_size_ptr(StringList list);
-SizeType* get_capacity_ptr(StringList list);
-SizeType string_list_capacity(StringList list);
 ErrorCode extend_string_list(StringList* list_ptr, const SizeType new_capacity);
-SizeType next_capacity(const SizeType old_capacity);
-ErrorCode place_element(StringList list, const SizeType index, cString str);
-void replace_in_string(mString string, cString before, cString after);
+bool string_less(cString left, cString right);
+bool string_greater(cString left, cString right);
+ErrorCode write_all(const int fd, cString buffer, SizeType bytes_count);
+#ifndef _WIN32
+ErrorCode write_batch(const int fd, struct iovec* batch, int count);
+#endif
+unsigned lowest_set_bit(unsigned mask);
+unsigned set_bits_count(unsigned mask);
+SizeType count_delimiters(const CharType* position, const CharType* end, const CharType delimiter);
+const CharType* find_delimiter(const CharType* position, const CharType* end, const CharType delimiter);
+void put_key_byte(mString key_buffer, const SizeType buffer_size, SizeType* position, const CharType byte);
+void release_element(mString element);
+void release_arena_reference(SizeType* arena);
+SizeType* allocate_arena(const SizeType payload_bytes);
+mString pack_element(SizeType* arena, SizeType* used_bytes, const CharType* str, const SizeType length);
+SizeType storage_bytes_for_length(const SizeType length);
+SizeType element_storage_bytes(cString element);
+SizeType element_released_bytes(cString element);
+void move_element_to_arena(StringList list, const SizeType index, StringListCompaction* compaction);
+void append_element(StringList list, mString element);
+void append_unique_sorted_element(StringList list, mString element);
+void release_pointer_block(StringList* list_ptr);
+bool is_sorted_ascending(StringList list);
+void merge_set_operation(StringList first, StringList second, StringList result, SetOperation operation);
+ErrorCode hashed_set_operation(StringList first, StringList second, StringList result, SetOperation operation);
+SizeType hash_string(cString str);
+ErrorCode string_hash_set_init(StringHashSet* set, const SizeType expected_count);
+void string_hash_set_destroy(StringHashSet* set);
+SizeType string_hash_set_find_slot(const StringHashSet* set, cString str);
+bool string_hash_set_insert(StringHashSet* set, cString str);
+bool string_hash_set_contains(const StringHashSet* set, cString str);
 
 // Validators forwarded declarations
 ErrorCode validate_input_string_list_ptr(StringList*);
@@ -39,6 +144,14 @@ ErrorCode validate_input_string_list(StringList);
 ErrorCode validate_input_string(cString);
 ErrorCode validate_input_bool_ptr(bool* ptr);
 ErrorCode validate_input_size_ptr(SizeType* ptr);
+ErrorCode validate_input_string_list_out_ptr(StringList* list_ptr);
+ErrorCode validate_input_string_out_ptr(mString* ptr);
+ErrorCode validate_input_counts_out_ptr(SizeType** ptr);
+ErrorCode validate_input_fd(const int fd);
+ErrorCode validate_input_buffer(cString buffer);
+ErrorCode validate_input_key_function(StringKeyFunction key_function);
+ErrorCode validate_input_compaction_ptr(StringListCompaction* ptr);
+ErrorCode validate_input_set_operands(StringList* first, StringList* second, StringList* result);
 
 // Validational decorators
 
@@ -207,341 +320,1565 @@ PUBLIC ErrorCode string_list_sort(StringList list)
     return impl_string_list_sort(list);
 }
 
+PUBLIC ErrorCode string_list_partial_sort(StringList list, SizeType k)
+{
+    ErrorCode list_validation_error = validate_input_string_list(list);
 
-// Actual implementations
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
 
-PRIVATE ErrorCode impl_string_list_init(StringList* list_ptr)
+    return impl_string_list_partial_sort(list, k, false);
+}
+
+PUBLIC ErrorCode string_list_partial_sort_descending(StringList list, SizeType k)
 {
-    const size_t bytes_to_allocate_count = allocating_bytes_count(INITIAL_CAPACITY);
-    const bool size_type_overflow_detected = bytes_to_allocate_count < INITIAL_CAPACITY ||
-        bytes_to_allocate_count < FIELDS_BLOCK_SIZE;
-    if (size_type_overflow_detected)
+    ErrorCode list_validation_error = validate_input_string_list(list);
+
+    if (list_validation_error != ErrorCode::Success)
     {
-        return ErrorCode::LackOfMemory;
+        return list_validation_error;
     }
 
-    void* allocated_chunk = malloc(bytes_to_allocate_count);
+    return impl_string_list_partial_sort(list, k, true);
+}
+
+PUBLIC ErrorCode string_list_nth_element(StringList list, SizeType n)
+{
+    ErrorCode list_validation_error = validate_input_string_list(list);
 
-    if (allocated_chunk == nullptr)
+    if (list_validation_error != ErrorCode::Success)
     {
-        return ErrorCode::LackOfMemory;
+        return list_validation_error;
     }
 
-    *list_ptr = (StringList)allocated_chunk;
-    set_fields_block(*list_ptr);
-    move_to_the_strings_block(list_ptr);
-
-    return ErrorCode::Success;
+    return impl_string_list_nth_element(list, n);
 }
 
-PRIVATE ErrorCode impl_string_list_destroy(StringList* list)
+PUBLIC ErrorCode string_list_sort_by(StringList list, StringKeyFunction key_function)
 {
-    for (SizeType i = 0u; i < impl_string_list_size(*list); ++i)
+    ErrorCode list_validation_error = validate_input_string_list(list);
+    ErrorCode key_function_validation_error = validate_input_key_function(key_function);
+
+    if (list_validation_error != ErrorCode::Success)
     {
-        free((*list)[i]);
+        return list_validation_error;
     }
 
-    move_to_the_fields_block(list);
-    free(*list);
-    *list = nullptr;
+    if (key_function_validation_error != ErrorCode::Success)
+    {
+        return key_function_validation_error;
+    }
 
-    return ErrorCode::Success;
+    return impl_string_list_sort_by(list, key_function);
 }
 
-PRIVATE bool impl_string_list_is_empty(StringList list)
+PUBLIC ErrorCode string_list_join(StringList list, cString separator, mString* result)
 {
-    return impl_string_list_size(list) == 0u;
+    ErrorCode list_validation_error = validate_input_string_list(list);
+    ErrorCode separator_validation_error = validate_input_string(separator);
+    ErrorCode result_validation_error = validate_input_string_out_ptr(result);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
+
+    if (separator_validation_error != ErrorCode::Success)
+    {
+        return separator_validation_error;
+    }
+
+    if (result_validation_error != ErrorCode::Success)
+    {
+        return result_validation_error;
+    }
+
+    return impl_string_list_join(list, separator, result);
 }
 
-PRIVATE ErrorCode impl_string_list_add(StringList* list_ptr, cString str)
+PUBLIC ErrorCode string_list_write_fd(StringList list, int fd, cString separator)
 {
-    const SizeType size = impl_string_list_size(*list_ptr);
-    const SizeType capacity = string_list_capacity(*list_ptr);
+    ErrorCode list_validation_error = validate_input_string_list(list);
+    ErrorCode fd_validation_error = validate_input_fd(fd);
+    ErrorCode separator_validation_error = validate_input_string(separator);
+
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
 
-    if (size == capacity)
+    if (separator_validation_error != ErrorCode::Success)
     {
-        const SizeType new_capacity = next_capacity(capacity);
-        ErrorCode result_code = extend_string_list(list_ptr, new_capacity);
+        return separator_validation_error;
+    }
 
-        if (result_code != ErrorCode::Success)
-        {
-            return result_code;
-        }
+    if (fd_validation_error != ErrorCode::Success)
+    {
+        return fd_validation_error;
     }
 
-    ErrorCode result_code = place_element(*list_ptr, size, str);
+    return impl_string_list_write_fd(list, fd, separator);
+}
 
-    if (result_code != ErrorCode::Success)
+PUBLIC ErrorCode string_list_from_split(cString buffer, SizeType length, CharType delimiter, StringList* result)
+{
+    ErrorCode buffer_validation_error = validate_input_buffer(buffer);
+    ErrorCode result_validation_error = validate_input_string_list_out_ptr(result);
+
+    if (buffer_validation_error != ErrorCode::Success)
     {
-        return result_code;
+        return buffer_validation_error;
     }
 
-    SizeType* size_ptr = get_size_ptr(*list_ptr);
-    ++(*size_ptr);
+    if (result_validation_error != ErrorCode::Success)
+    {
+        return result_validation_error;
+    }
 
-    return ErrorCode::Success;
+    return impl_string_list_from_split(buffer, length, delimiter, result);
 }
 
-PRIVATE ErrorCode impl_string_list_remove(StringList list, cString str)
+PUBLIC SizeType string_key_case_insensitive(cString str, mString key_buffer, SizeType buffer_size)
 {
-    if (impl_string_list_is_empty(list))
+    const SizeType length = strlen(str);
+
+    if (length > buffer_size)
     {
-        return ErrorCode::Success;
+        return length;
+    }
+
+    for (SizeType i = 0u; i < length; ++i)
+    {
+        key_buffer[i] = (CharType)tolower((unsigned char)str[i]);
     }
 
-    StringList writing_ptr = list;
-    StringList reading_ptr = list;
-    StringList end_ptr = list + impl_string_list_size(list);
-    SizeType new_size = 0u;
+    return length;
+}
+
+// Every run of digits becomes the marker, the count of its significant digits and
+// the digits themselves, so that bytewise comparison orders the runs by value.
+// The marker is a digit itself, which keeps runs ordered against other characters.
+PUBLIC SizeType string_key_natural(cString str, mString key_buffer, SizeType buffer_size)
+{
+    SizeType position = 0u;
 
-    for (; reading_ptr != end_ptr; ++reading_ptr)
+    while (*str != '\0')
     {
-        mString read_word = *reading_ptr;
+        if (!isdigit((unsigned char)*str))
+        {
+            put_key_byte(key_buffer, buffer_size, &position, *str);
+            ++str;
+            continue;
+        }
 
-        if (strcmp(read_word, str) != 0)
+        while (*str == '0')
         {
-            *writing_ptr = *reading_ptr;
-            ++writing_ptr;
-            ++new_size;
+            ++str;
         }
-        else
+
+        cString digits = str;
+
+        while (isdigit((unsigned char)*str))
         {
-            free(read_word);
+            ++str;
         }
-    }
 
-    SizeType* size_ptr = get_size_ptr(list);
-    *size_ptr = new_size;
+        const SizeType digits_count = str - digits;
+        put_key_byte(key_buffer, buffer_size, &position, NATURAL_KEY_NUMBER_MARKER);
 
-    return ErrorCode::Success;
-}
+        if (digits_count < NATURAL_KEY_LONG_NUMBER_LENGTH)
+        {
+            put_key_byte(key_buffer, buffer_size, &position, (CharType)digits_count);
+        }
+        else
+        {
+            put_key_byte(key_buffer, buffer_size, &position, (CharType)NATURAL_KEY_LONG_NUMBER_LENGTH);
 
-PRIVATE SizeType impl_string_list_size(StringList list)
-{
-    return *get_size_ptr(list);
-}
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                put_key_byte(key_buffer, buffer_size, &position, (CharType)(digits_count >> shift));
+            }
+        }
 
-PRIVATE SizeType impl_string_list_index_of(StringList list, cString str)
-{
-    for (SizeType i = 0u; i < impl_string_list_size(list); ++i)
-    {
-        if (strcmp(list[i], str) == 0)
+        for (SizeType i = 0u; i < digits_count; ++i)
         {
-            return i;
+            put_key_byte(key_buffer, buffer_size, &position, digits[i]);
         }
     }
 
-    return (SizeType)(-1);
+    return position;
 }
 
-PRIVATE ErrorCode impl_string_list_remove_duplicates(StringList* list)
+PUBLIC ErrorCode string_list_union(StringList* first, StringList* second, StringList* result)
 {
-    StringList result;
-    string_list_init(&result);
+    ErrorCode operands_validation_error = validate_input_set_operands(first, second, result);
 
-    for (SizeType i = 0u; i < impl_string_list_size(*list); ++i)
+    if (operands_validation_error != ErrorCode::Success)
     {
-        mString read_string = (*list)[i];
-
-        if (impl_string_list_index_of(result, read_string) == -1)
-        {
-            string_list_add(&result, read_string);
-        }
+        return operands_validation_error;
     }
 
-    string_list_destroy(list);
-    *list = result;
-
-    return ErrorCode::Success;
+    return impl_string_list_set_operation(first, second, result, SetOperation::Union);
 }
 
-PRIVATE ErrorCode impl_string_list_replace_in_strings(StringList list, cString before, cString after)
+PUBLIC ErrorCode string_list_intersection(StringList* first, StringList* second, StringList* result)
 {
-    for (SizeType i = 0u; i < impl_string_list_size(list); ++i)
+    ErrorCode operands_validation_error = validate_input_set_operands(first, second, result);
+
+    if (operands_validation_error != ErrorCode::Success)
     {
-        replace_in_string(list[i], before, after);
+        return operands_validation_error;
     }
 
-    return ErrorCode::Success;
+    return impl_string_list_set_operation(first, second, result, SetOperation::Intersection);
 }
 
-PRIVATE ErrorCode impl_string_list_sort(StringList list)
+PUBLIC ErrorCode string_list_difference(StringList* first, StringList* second, StringList* result)
 {
-    if (impl_string_list_is_empty(list))
-    {
-        return ErrorCode::Success;
-    }
+    ErrorCode operands_validation_error = validate_input_set_operands(first, second, result);
 
-    for (SizeType i = 0u; i < impl_string_list_size(list) - 1; ++i)
+    if (operands_validation_error != ErrorCode::Success)
     {
-        SizeType min_index = i;
-        for (SizeType j = i + 1; j < impl_string_list_size(list); ++j)
-        {
-            if (strcmp(list[j], list[min_index]) < 0)
-            {
-                min_index = j;
-            }
-        }
-
-        mString temp = list[i];
-        list[i] = list[min_index];
-        list[min_index] = temp;
+        return operands_validation_error;
     }
 
-    return ErrorCode::Success;
+    return impl_string_list_set_operation(first, second, result, SetOperation::Difference);
 }
 
+PUBLIC ErrorCode string_list_clone(StringList list, StringList* result)
+{
+    ErrorCode list_validation_error = validate_input_string_list(list);
+    ErrorCode result_validation_error = validate_input_string_list_out_ptr(result);
 
-// Additional utilities
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
 
-PRIVATE inline size_t allocating_bytes_count(const SizeType capacity)
-{
-    return capacity * sizeof(mString) + FIELDS_BLOCK_SIZE;
-}
+    if (result_validation_error != ErrorCode::Success)
+    {
+        return result_validation_error;
+    }
 
-PRIVATE void move_to_the_fields_block(StringList* list_ptr)
-{
-    StringList list = *list_ptr;
-    SizeType* reinterpreted_list = (SizeType*)list;
-    reinterpreted_list -= 2;
-    *list_ptr = (StringList)reinterpreted_list;
+    return impl_string_list_clone(list, result);
 }
 
-PRIVATE void move_to_the_strings_block(StringList* list_ptr)
+PUBLIC ErrorCode string_list_count_occurrences(StringList list, StringList* unique_list, SizeType** counts, bool sort_by_count)
 {
-    StringList list = *list_ptr;
-    SizeType* reinterpreted_list = (SizeType*)list;
-    reinterpreted_list += 2;
-    *list_ptr = (StringList)reinterpreted_list;
-}
+    ErrorCode list_validation_error = validate_input_string_list(list);
+    ErrorCode unique_list_validation_error = validate_input_string_list_out_ptr(unique_list);
+    ErrorCode counts_validation_error = validate_input_counts_out_ptr(counts);
 
-PRIVATE void set_fields_block(StringList list)
-{
-    const SizeType initial_size = 0u;
-    SizeType* fields_view = (SizeType*)list;
-    fields_view[0] = initial_size;
-    fields_view[1] = INITIAL_CAPACITY;
-}
+    if (list_validation_error != ErrorCode::Success)
+    {
+        return list_validation_error;
+    }
 
-PRIVATE SizeType* get_size_ptr(StringList list)
-{
-    move_to_the_fields_block(&list);
-    return (SizeType*)list;
-}
+    if (unique_list_validation_error != ErrorCode::Success)
+    {
+        return unique_list_validation_error;
+    }
 
-PRIVATE SizeType* get_capacity_ptr(StringList list)
-{
-    move_to_the_fields_block(&list);
-    return (SizeType*)list + 1;
-}
+    if (counts_validation_error != ErrorCode::Success)
+    {
+        return counts_validation_error;
+    }
 
-PRIVATE SizeType string_list_capacity(StringList list)
-{
-    return *get_capacity_ptr(list);
+    return impl_string_list_count_occurrences(list, unique_list, counts, sort_by_count);
 }
 
-PRIVATE ErrorCode extend_string_list(StringList* list_ptr, const SizeType new_capacity)
+PUBLIC ErrorCode string_list_compact(StringList* list_ptr, SizeType* reclaimed_bytes)
 {
-    StringList old_strings_view = *list_ptr;
-    const SizeType realloc_bytes_count = allocating_bytes_count(new_capacity);
-    move_to_the_fields_block(list_ptr);
-    void* new_chunk = realloc(*list_ptr, realloc_bytes_count);
+    ErrorCode list_ptr_validation_error = validate_input_string_list_ptr(list_ptr);
+    ErrorCode size_validation_error = validate_input_size_ptr(reclaimed_bytes);
 
-    if (new_chunk == nullptr)
+    if (list_ptr_validation_error != ErrorCode::Success)
     {
-        return ErrorCode::LackOfMemory;
+        return list_ptr_validation_error;
     }
 
-    if (new_chunk != *list_ptr)
+    if (size_validation_error != ErrorCode::Success)
     {
-        const SizeType old_capacity = string_list_capacity(old_strings_view);
-        const SizeType old_bytes_count = allocating_bytes_count(old_capacity);
-        memcpy(new_chunk, *list_ptr, old_bytes_count);
-        *list_ptr = (StringList)new_chunk;
+        return size_validation_error;
     }
 
-    move_to_the_strings_block(list_ptr);
-
-    SizeType* capacity_ptr = get_capacity_ptr(*list_ptr);
-    *capacity_ptr = new_capacity;
+    StringListCompaction compaction {};
+    bool finished = false;
 
-    return ErrorCode::Success;
+    return impl_string_list_compact_step(list_ptr, &compaction, UNLIMITED_TIME_BUDGET, reclaimed_bytes, &finished);
 }
 
-PRIVATE inline SizeType next_capacity(const SizeType old_capacity)
+PUBLIC ErrorCode string_list_compact_step(StringList* list_ptr, StringListCompaction* compaction, SizeType time_budget_us, SizeType* reclaimed_bytes, bool* finished)
 {
-    return 1 + (old_capacity << 1);
-}
+    ErrorCode list_ptr_validation_error = validate_input_string_list_ptr(list_ptr);
+    ErrorCode compaction_validation_error = validate_input_compaction_ptr(compaction);
+    ErrorCode size_validation_error = validate_input_size_ptr(reclaimed_bytes);
+    ErrorCode bool_ptr_validation_error = validate_input_bool_ptr(finished);
 
-PRIVATE ErrorCode place_element(StringList list, const SizeType index, cString str)
-{
-    const size_t allocated_bytes_count = strlen(str) + 1;
-    void* allocated_memory = malloc(allocated_bytes_count);
+    if (list_ptr_validation_error != ErrorCode::Success)
+    {
+        return list_ptr_validation_error;
+    }
 
-    if (allocated_memory == nullptr)
+    if (compaction_validation_error != ErrorCode::Success)
     {
-        return ErrorCode::LackOfMemory;
+        return compaction_validation_error;
     }
 
-    list[index] = (mString)allocated_memory;
-    strcpy_s(list[index], allocated_bytes_count, str);
+    if (size_validation_error != ErrorCode::Success)
+    {
+        return size_validation_error;
+    }
 
-    return ErrorCode::Success;
+    if (bool_ptr_validation_error != ErrorCode::Success)
+    {
+        return bool_ptr_validation_error;
+    }
+
+    return impl_string_list_compact_step(list_ptr, compaction, time_budget_us, reclaimed_bytes, finished);
 }
 
-PRIVATE void replace_in_string(mString string, cString before, cString after)
+PUBLIC ErrorCode string_list_compact_abort(StringListCompaction* compaction)
 {
-    const SizeType string_len = strlen(string);
-    const SizeType before_len = strlen(before);
-    const SizeType after_len = strlen(after);
+    ErrorCode validation_error = validate_input_compaction_ptr(compaction);
 
-    if (string_len == 0u)
+    if (validation_error != ErrorCode::Success)
     {
-        return;
+        return validation_error;
     }
 
-    for (SizeType i = 0; i <= string_len - before_len; ++i)
-    {
-        if (strncmp(string + i, before, before_len) == 0)
-        {
-            memmove(string + i + after_len, string + i + before_len, string_len - i - before_len + 1);
-            memcpy(string + i, after, after_len);
-            i += after_len - 1;
-        }
-    }
+    return impl_string_list_compact_abort(compaction);
 }
 
 
-// Validators implementations
+// Actual implementations
 
-PRIVATE inline ErrorCode validate_not_nullptr(const void* ptr)
+PRIVATE ErrorCode impl_string_list_init(StringList* list_ptr)
 {
-    return ptr == nullptr
-         ? ErrorCode::NullPointerInput
-         : ErrorCode::Success;
+    return init_string_list(list_ptr, default_allocator);
 }
 
-PRIVATE inline ErrorCode validate_input_string_list_ptr(StringList* list_ptr)
+PRIVATE ErrorCode impl_string_list_destroy(StringList* list)
 {
-    return validate_not_nullptr(list_ptr);
+    return destroy_string_list(list, default_allocator);
 }
 
-PRIVATE inline ErrorCode validate_input_string_list(StringList list)
+PRIVATE bool impl_string_list_is_empty(StringList list)
 {
-    return validate_not_nullptr(list);
+    return impl_string_list_size(list) == 0u;
 }
 
-PRIVATE inline ErrorCode validate_input_string(cString str)
+PRIVATE ErrorCode impl_string_list_add(StringList* list_ptr, cString str)
 {
-    return validate_not_nullptr(str);
+    return add_string(list_ptr, str, default_allocator);
 }
 
-PRIVATE inline ErrorCode validate_input_bool_ptr(bool* ptr)
+PRIVATE ErrorCode impl_string_list_remove(StringList list, cString str)
 {
-    return validate_not_nullptr(ptr);
+    if (impl_string_list_is_empty(list))
+    {
+        return ErrorCode::Success;
+    }
+
+    return remove_string(list, str, default_allocator);
 }
 
-PRIVATE inline ErrorCode validate_input_size_ptr(SizeType* ptr)
+PRIVATE SizeType impl_string_list_size(StringList list)
 {
-    return validate_not_nullptr(ptr);
+    return *get_size_ptr(list);
+}
+
+PRIVATE SizeType impl_string_list_index_of(StringList list, cString str)
+{
+    for (SizeType i = 0u; i < impl_string_list_size(list); ++i)
+    {
+        if (strcmp(list[i], str) == 0)
+        {
+            return i;
+        }
+    }
+
+    return (SizeType)(-1);
+}
+
+PRIVATE ErrorCode impl_string_list_remove_duplicates(StringList* list)
+{
+    return remove_duplicates(*list, default_allocator);
+}
+
+PRIVATE ErrorCode impl_string_list_replace_in_strings(StringList list, cString before, cString after)
+{
+    return replace_in_strings(list, before, after, default_allocator);
+}
+
+PRIVATE ErrorCode impl_string_list_sort(StringList list)
+{
+    if (impl_string_list_is_empty(list))
+    {
+        return ErrorCode::Success;
+    }
+
+    for (SizeType i = 0u; i < impl_string_list_size(list) - 1; ++i)
+    {
+        SizeType min_index = i;
+        for (SizeType j = i + 1; j < impl_string_list_size(list); ++j)
+        {
+            if (strcmp(list[j], list[min_index]) < 0)
+            {
+                min_index = j;
+            }
+        }
+
+        mString temp = list[i];
+        list[i] = list[min_index];
+        list[min_index] = temp;
+    }
+
+    return ErrorCode::Success;
+}
+
+// Heap based selection: about n comparisons plus k log k for the final ordering
+PRIVATE ErrorCode impl_string_list_partial_sort(StringList list, SizeType k, const bool descending)
+{
+    const SizeType size = impl_string_list_size(list);
+
+    if (k > size)
+    {
+        k = size;
+    }
+
+    std::partial_sort(list, list + k, list + size, descending ? string_greater : string_less);
+
+    return ErrorCode::Success;
+}
+
+// Introselect: linear on average, falls back to heap selection on bad pivots
+PRIVATE ErrorCode impl_string_list_nth_element(StringList list, const SizeType n)
+{
+    const SizeType size = impl_string_list_size(list);
+
+    if (n >= size)
+    {
+        return ErrorCode::IndexOutOfRange;
+    }
+
+    std::nth_element(list, list + n, list + size, string_less);
+
+    return ErrorCode::Success;
+}
+
+// Every key is computed once into one contiguous buffer, the entries are sorted by
+// plain memcmp of their keys and the list is then rewritten in the sorted order
+PRIVATE ErrorCode impl_string_list_sort_by(StringList list, StringKeyFunction key_function)
+{
+    const SizeType size = impl_string_list_size(list);
+    SizeType keys_capacity = size * ESTIMATED_SORT_KEY_LENGTH;
+    SizeType keys_length = 0u;
+    const SizeType entries_bytes = size * sizeof(SortKeyEntry) + 1;
+    SortKeyEntry* entries = (SortKeyEntry*)default_allocator.allocate(entries_bytes);
+    mString keys = (mString)default_allocator.allocate(keys_capacity + 1);
+
+    if (entries == nullptr || keys == nullptr)
+    {
+        default_allocator.deallocate(entries, entries_bytes);
+        default_allocator.deallocate(keys, keys_capacity + 1);
+        return ErrorCode::LackOfMemory;
+    }
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        SizeType key_length = key_function(list[i], keys + keys_length, keys_capacity - keys_length);
+
+        if (key_length > keys_capacity - keys_length)
+        {
+            const SizeType extended_capacity = std::max(keys_capacity << 1, keys_length + key_length);
+            mString extended_keys = (mString)default_allocator.reallocate(keys, keys_capacity + 1, extended_capacity + 1);
+
+            if (extended_keys == nullptr)
+            {
+                default_allocator.deallocate(entries, entries_bytes);
+                default_allocator.deallocate(keys, keys_capacity + 1);
+                return ErrorCode::LackOfMemory;
+            }
+
+            keys = extended_keys;
+            keys_capacity = extended_capacity;
+            key_length = key_function(list[i], keys + keys_length, keys_capacity - keys_length);
+        }
+
+        entries[i].offset = keys_length;
+        entries[i].length = key_length;
+        entries[i].element = list[i];
+        keys_length += key_length;
+    }
+
+    std::stable_sort(entries, entries + size, [keys](const SortKeyEntry& left, const SortKeyEntry& right)
+    {
+        const int comparison = memcmp(keys + left.offset, keys + right.offset, std::min(left.length, right.length));
+
+        return comparison != 0
+             ? comparison < 0
+             : left.length < right.length;
+    });
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        list[i] = entries[i].element;
+    }
+
+    default_allocator.deallocate(entries, entries_bytes);
+    default_allocator.deallocate(keys, keys_capacity + 1);
+
+    return ErrorCode::Success;
+}
+
+PRIVATE ErrorCode impl_string_list_join(StringList list, cString separator, mString* result)
+{
+    const SizeType size = impl_string_list_size(list);
+    const SizeType separator_length = strlen(separator);
+    SizeType total_length = size == 0u ? 0u : (size - 1) * separator_length;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        total_length += strlen(list[i]);
+    }
+
+    mString joined = (mString)default_allocator.allocate(total_length + 1);
+
+    if (joined == nullptr)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    mString position = joined;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        if (i != 0u)
+        {
+            memcpy(position, separator, separator_length);
+            position += separator_length;
+        }
+
+        const SizeType length = strlen(list[i]);
+        memcpy(position, list[i], length);
+        position += length;
+    }
+
+    *position = '\0';
+    *result = joined;
+
+    return ErrorCode::Success;
+}
+
+#ifdef _WIN32
+
+// There is no writev here, the whole list goes out in one write of the joined buffer
+PRIVATE ErrorCode impl_string_list_write_fd(StringList list, const int fd, cString separator)
+{
+    mString joined = nullptr;
+    ErrorCode result_code = impl_string_list_join(list, separator, &joined);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    const SizeType joined_length = strlen(joined);
+    result_code = write_all(fd, joined, joined_length);
+    default_allocator.deallocate(joined, joined_length + 1);
+
+    return result_code;
+}
+
+#else
+
+// The iovecs point straight at the payloads, so nothing is copied on the way out
+PRIVATE ErrorCode impl_string_list_write_fd(StringList list, const int fd, cString separator)
+{
+    const SizeType size = impl_string_list_size(list);
+    const SizeType separator_length = strlen(separator);
+    struct iovec batch[WRITE_BATCH_SIZE];
+    int count = 0;
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        if (i != 0u && separator_length != 0u)
+        {
+            batch[count].iov_base = (void*)separator;
+            batch[count].iov_len = separator_length;
+            ++count;
+        }
+
+        batch[count].iov_base = list[i];
+        batch[count].iov_len = strlen(list[i]);
+        ++count;
+
+        if (count >= (int)WRITE_BATCH_SIZE - 1)
+        {
+            ErrorCode result_code = write_batch(fd, batch, count);
+
+            if (result_code != ErrorCode::Success)
+            {
+                return result_code;
+            }
+
+            count = 0;
+        }
+    }
+
+    return write_batch(fd, batch, count);
+}
+
+#endif
+
+// A vectorised count of the delimiters sizes the pointer array and a single arena
+// up front, then every token is copied once into the arena right behind the last one
+PRIVATE ErrorCode impl_string_list_from_split(cString buffer, const SizeType length, const CharType delimiter, StringList* result)
+{
+    const CharType* end = buffer + length;
+    const SizeType delimiters_count = count_delimiters(buffer, end, delimiter);
+    const SizeType tokens_count = length == 0u ? 0u : delimiters_count + 1;
+    const SizeType alignment_slack = sizeof(SizeType) - 1;
+    const SizeType payload_bytes = length - delimiters_count +
+        tokens_count * (ELEMENT_HEADER_SIZE + 1 + alignment_slack);
+
+    StringList result_list = nullptr;
+    ErrorCode result_code = impl_string_list_init(&result_list);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    result_code = extend_string_list(&result_list, tokens_count);
+    SizeType* arena = result_code == ErrorCode::Success ? allocate_arena(payload_bytes) : nullptr;
+
+    if (arena == nullptr)
+    {
+        impl_string_list_destroy(&result_list);
+        return ErrorCode::LackOfMemory;
+    }
+
+    SizeType used_bytes = ARENA_HEADER_SIZE;
+    const CharType* token = buffer;
+
+    for (SizeType i = 0u; i < tokens_count; ++i)
+    {
+        const CharType* token_end = find_delimiter(token, end, delimiter);
+        append_element(result_list, pack_element(arena, &used_bytes, token, token_end - token));
+        token = token_end + 1;
+    }
+
+    release_arena_reference(arena);
+    *result = result_list;
+
+    return ErrorCode::Success;
+}
+
+PRIVATE ErrorCode impl_string_list_set_operation(StringList* first, StringList* second, StringList* result, SetOperation operation)
+{
+    const SizeType first_size = impl_string_list_size(*first);
+    const SizeType second_size = impl_string_list_size(*second);
+    SizeType result_capacity = first_size;
+
+    if (operation == SetOperation::Union)
+    {
+        result_capacity = first_size + second_size;
+    }
+    else if (operation == SetOperation::Intersection && second_size < first_size)
+    {
+        result_capacity = second_size;
+    }
+
+    StringList result_list = nullptr;
+    ErrorCode result_code = impl_string_list_init(&result_list);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    result_code = extend_string_list(&result_list, result_capacity);
+
+    if (result_code != ErrorCode::Success)
+    {
+        impl_string_list_destroy(&result_list);
+        return result_code;
+    }
+
+    if (is_sorted_ascending(*first) && is_sorted_ascending(*second))
+    {
+        merge_set_operation(*first, *second, result_list, operation);
+    }
+    else
+    {
+        result_code = hashed_set_operation(*first, *second, result_list, operation);
+
+        if (result_code != ErrorCode::Success)
+        {
+            impl_string_list_destroy(&result_list);
+            return result_code;
+        }
+    }
+
+    release_pointer_block(first);
+    release_pointer_block(second);
+    *result = result_list;
+
+    return ErrorCode::Success;
+}
+
+// The clone gets its own pointer array but shares every payload with the source;
+// a shared payload is copied only when replace_in_strings is about to modify it
+PRIVATE ErrorCode impl_string_list_clone(StringList list, StringList* result)
+{
+    const SizeType size = impl_string_list_size(list);
+    StringList result_list = nullptr;
+    ErrorCode result_code = impl_string_list_init(&result_list);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    result_code = extend_string_list(&result_list, size);
+
+    if (result_code != ErrorCode::Success)
+    {
+        impl_string_list_destroy(&result_list);
+        return result_code;
+    }
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        share_element(list[i]);
+        append_element(result_list, list[i]);
+    }
+
+    *result = result_list;
+
+    return ErrorCode::Success;
+}
+
+
+// One pass over the list aggregates into a hash set whose slots map to positions in
+// the unique list; the unique list shares its payloads with the source
+PRIVATE ErrorCode impl_string_list_count_occurrences(StringList list, StringList* unique_list, SizeType** counts, const bool sort_by_count)
+{
+    const SizeType size = impl_string_list_size(list);
+    StringList result_list = nullptr;
+    StringHashSet seen;
+    ErrorCode result_code = impl_string_list_init(&result_list);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    result_code = extend_string_list(&result_list, size);
+
+    if (result_code != ErrorCode::Success || string_hash_set_init(&seen, size) != ErrorCode::Success)
+    {
+        impl_string_list_destroy(&result_list);
+        return ErrorCode::LackOfMemory;
+    }
+
+    const SizeType unique_index_of_slot_bytes = (seen.mask + 1) * sizeof(SizeType);
+    const SizeType result_counts_bytes = size * sizeof(SizeType) + 1;
+    SizeType* unique_index_of_slot = (SizeType*)default_allocator.allocate(unique_index_of_slot_bytes);
+    SizeType* result_counts = (SizeType*)default_allocator.allocate(result_counts_bytes);
+
+    if (unique_index_of_slot == nullptr || result_counts == nullptr)
+    {
+        default_allocator.deallocate(unique_index_of_slot, unique_index_of_slot_bytes);
+        default_allocator.deallocate(result_counts, result_counts_bytes);
+        string_hash_set_destroy(&seen);
+        impl_string_list_destroy(&result_list);
+        return ErrorCode::LackOfMemory;
+    }
+
+    for (SizeType i = 0u; i < size; ++i)
+    {
+        const SizeType slot = string_hash_set_find_slot(&seen, list[i]);
+
+        if (seen.slots[slot] != nullptr)
+        {
+            ++result_counts[unique_index_of_slot[slot]];
+            continue;
+        }
+
+        const SizeType unique_index = impl_string_list_size(result_list);
+        seen.slots[slot] = list[i];
+        unique_index_of_slot[slot] = unique_index;
+        result_counts[unique_index] = 1u;
+        share_element(list[i]);
+        append_element(result_list, list[i]);
+    }
+
+    default_allocator.deallocate(unique_index_of_slot, unique_index_of_slot_bytes);
+    string_hash_set_destroy(&seen);
+
+    const SizeType unique_count = impl_string_list_size(result_list);
+    const SizeType entries_bytes = unique_count * sizeof(OccurrenceEntry) + 1;
+    OccurrenceEntry* entries = sort_by_count ? (OccurrenceEntry*)default_allocator.allocate(entries_bytes) : nullptr;
+
+    if (sort_by_count && entries == nullptr)
+    {
+        default_allocator.deallocate(result_counts, result_counts_bytes);
+        impl_string_list_destroy(&result_list);
+        return ErrorCode::LackOfMemory;
+    }
+
+    if (sort_by_count)
+    {
+        for (SizeType i = 0u; i < unique_count; ++i)
+        {
+            entries[i].count = result_counts[i];
+            entries[i].element = result_list[i];
+        }
+
+        // Most frequent first, equally frequent strings keep their first occurrence order
+        std::stable_sort(entries, entries + unique_count, [](const OccurrenceEntry& left, const OccurrenceEntry& right)
+        {
+            return left.count > right.count;
+        });
+
+        for (SizeType i = 0u; i < unique_count; ++i)
+        {
+            result_counts[i] = entries[i].count;
+            result_list[i] = entries[i].element;
+        }
+
+        default_allocator.deallocate(entries, entries_bytes);
+    }
+
+    // A failed shrink keeps the larger pointer array, which is still valid
+    extend_string_list(&result_list, unique_count);
+    *unique_list = result_list;
+    *counts = result_counts;
+
+    return ErrorCode::Success;
+}
+
+// A step first measures the live payloads, then allocates one arena for all of them
+// and moves the payloads into it in list order, and finally right-sizes the pointer
+// array. Every phase resumes from compaction->cursor once the time budget runs out.
+PRIVATE ErrorCode impl_string_list_compact_step(StringList* list_ptr, StringListCompaction* compaction, const SizeType time_budget_us, SizeType* reclaimed_bytes, bool* finished)
+{
+    typedef std::chrono::steady_clock Clock;
+    const unsigned long long budget_us = time_budget_us == UNLIMITED_TIME_BUDGET
+        ? 0u
+        : std::min<unsigned long long>(time_budget_us, MAX_TIME_BUDGET_US);
+    const Clock::time_point deadline = Clock::now() + std::chrono::microseconds((long long)budget_us);
+    const SizeType size = impl_string_list_size(*list_ptr);
+    *finished = false;
+
+    for (;;)
+    {
+        while (compaction->cursor < size)
+        {
+            const SizeType index = compaction->cursor++;
+
+            if (compaction->arena == nullptr)
+            {
+                compaction->arena_bytes += element_storage_bytes((*list_ptr)[index]);
+            }
+            else
+            {
+                move_element_to_arena(*list_ptr, index, compaction);
+            }
+
+            const bool check_clock = time_budget_us != UNLIMITED_TIME_BUDGET &&
+                compaction->cursor % COMPACTION_CLOCK_CHECK_INTERVAL == 0u;
+
+            if (check_clock && Clock::now() >= deadline)
+            {
+                return ErrorCode::Success;
+            }
+        }
+
+        if (compaction->arena != nullptr)
+        {
+            break;
+        }
+
+        SizeType* arena = allocate_arena(compaction->arena_bytes);
+
+        if (arena == nullptr)
+        {
+            return ErrorCode::LackOfMemory;
+        }
+
+        compaction->arena = arena;
+        compaction->arena_bytes = arena[1];
+        compaction->used_bytes = ARENA_HEADER_SIZE;
+        compaction->cursor = 0u;
+
+        // Packing shares the deadline of the measuring phase, so one step stays within its budget
+        if (time_budget_us != UNLIMITED_TIME_BUDGET && Clock::now() >= deadline)
+        {
+            return ErrorCode::Success;
+        }
+    }
+
+    const SizeType capacity = string_list_capacity(*list_ptr);
+    ErrorCode result_code = extend_string_list(list_ptr, size);
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    const SizeType released_bytes = compaction->released_bytes + (capacity - size) * sizeof(mString);
+    const SizeType allocated_bytes = compaction->arena_bytes;
+    *reclaimed_bytes = released_bytes > allocated_bytes ? released_bytes - allocated_bytes : 0u;
+
+    release_arena_reference((SizeType*)compaction->arena);
+    *compaction = StringListCompaction {};
+    *finished = true;
+
+    return ErrorCode::Success;
+}
+
+// Payloads already moved keep the arena alive through their own references
+PRIVATE ErrorCode impl_string_list_compact_abort(StringListCompaction* compaction)
+{
+    if (compaction->arena != nullptr)
+    {
+        release_arena_reference((SizeType*)compaction->arena);
+    }
+
+    *compaction = StringListCompaction {};
+
+    return ErrorCode::Success;
+}
+
+
+// Additional utilities
+
+PRIVATE ErrorCode extend_string_list(StringList* list_ptr, const SizeType new_capacity)
+{
+    return string_list_detail::extend_string_list(list_ptr, new_capacity, default_allocator);
+}
+
+// Same byte ordering as string_list_sort
+PRIVATE inline bool string_less(cString left, cString right)
+{
+    return strcmp(left, right) < 0;
+}
+
+PRIVATE inline bool string_greater(cString left, cString right)
+{
+    return strcmp(left, right) > 0;
+}
+
+PRIVATE ErrorCode write_all(const int fd, cString buffer, SizeType bytes_count)
+{
+    while (bytes_count != 0u)
+    {
+#ifdef _WIN32
+        const unsigned chunk_bytes = bytes_count > INT_MAX ? INT_MAX : (unsigned)bytes_count;
+        const int written = _write(fd, buffer, chunk_bytes);
+#else
+        const ssize_t written = write(fd, buffer, bytes_count);
+
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+
+        if (written <= 0)
+        {
+            return ErrorCode::IoError;
+        }
+
+        buffer += written;
+        bytes_count -= written;
+    }
+
+    return ErrorCode::Success;
+}
+
+#ifndef _WIN32
+
+// Repeats writev until the whole batch is written, skipping what a short write took
+PRIVATE ErrorCode write_batch(const int fd, struct iovec* batch, int count)
+{
+    while (count > 0)
+    {
+        // Empty entries up front would make a successful writev return 0
+        if (batch->iov_len == 0u)
+        {
+            ++batch;
+            --count;
+            continue;
+        }
+
+        const ssize_t written = writev(fd, batch, count);
+
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (written <= 0)
+        {
+            return ErrorCode::IoError;
+        }
+
+        SizeType remaining = (SizeType)written;
+
+        while (count > 0 && remaining >= batch->iov_len)
+        {
+            remaining -= batch->iov_len;
+            ++batch;
+            --count;
+        }
+
+        if (count > 0)
+        {
+            batch->iov_base = (CharType*)batch->iov_base + remaining;
+            batch->iov_len -= remaining;
+        }
+    }
+
+    return ErrorCode::Success;
+}
+
+#endif
+
+PRIVATE inline unsigned lowest_set_bit(unsigned mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0u;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+PRIVATE inline unsigned set_bits_count(unsigned mask)
+{
+    unsigned count = 0u;
+
+    for (; mask != 0u; mask &= mask - 1)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+PRIVATE SizeType count_delimiters(const CharType* position, const CharType* end, const CharType delimiter)
+{
+    SizeType count = 0u;
+
+#ifdef STRING_LIST_USE_AVX2
+    const __m256i wide_pattern = _mm256_set1_epi8(delimiter);
+
+    for (; end - position >= 32; position += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*)position);
+        count += set_bits_count((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, wide_pattern)));
+    }
+#endif
+
+#ifdef STRING_LIST_USE_SSE2
+    const __m128i pattern = _mm_set1_epi8(delimiter);
+
+    for (; end - position >= 16; position += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)position);
+        count += set_bits_count((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+    }
+#endif
+
+    for (; position != end; ++position)
+    {
+        count += *position == delimiter;
+    }
+
+    return count;
+}
+
+PRIVATE const CharType* find_delimiter(const CharType* position, const CharType* end, const CharType delimiter)
+{
+#ifdef STRING_LIST_USE_AVX2
+    const __m256i wide_pattern = _mm256_set1_epi8(delimiter);
+
+    for (; end - position >= 32; position += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*)position);
+        const unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, wide_pattern));
+
+        if (mask != 0u)
+        {
+            return position + lowest_set_bit(mask);
+        }
+    }
+#endif
+
+#ifdef STRING_LIST_USE_SSE2
+    const __m128i pattern = _mm_set1_epi8(delimiter);
+
+    for (; end - position >= 16; position += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)position);
+        const unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern));
+
+        if (mask != 0u)
+        {
+            return position + lowest_set_bit(mask);
+        }
+    }
+#endif
+
+    for (; position != end && *position != delimiter; ++position)
+    {
+    }
+
+    return position;
+}
+
+// Writes the byte only while it fits, the position keeps counting the full key length
+PRIVATE inline void put_key_byte(mString key_buffer, const SizeType buffer_size, SizeType* position, const CharType byte)
+{
+    if (*position < buffer_size)
+    {
+        key_buffer[*position] = byte;
+    }
+
+    ++(*position);
+}
+
+PRIVATE void release_element(mString element)
+{
+    string_list_detail::release_element(element, default_allocator);
+}
+
+PRIVATE inline SizeType* allocate_arena(const SizeType payload_bytes)
+{
+    return string_list_detail::allocate_arena(payload_bytes, default_allocator);
+}
+
+// Copies length bytes of str behind the last packed payload and terminates them
+PRIVATE mString pack_element(SizeType* arena, SizeType* used_bytes, const CharType* str, const SizeType length)
+{
+    SizeType* header = (SizeType*)((CharType*)arena + *used_bytes);
+    header[0] = 1u;
+    header[1] = (SizeType)arena;
+    mString packed_element = (mString)header + ELEMENT_HEADER_SIZE;
+    memcpy(packed_element, str, length);
+    packed_element[length] = '\0';
+
+    increment_count(&arena[0]);
+    *used_bytes += storage_bytes_for_length(length);
+
+    return packed_element;
+}
+
+PRIVATE void release_arena_reference(SizeType* arena)
+{
+    string_list_detail::release_arena_reference(arena, default_allocator);
+}
+
+// Bytes a payload takes inside an arena, rounded up to keep the headers aligned
+PRIVATE SizeType storage_bytes_for_length(const SizeType length)
+{
+    const SizeType alignment = sizeof(SizeType);
+    const SizeType bytes_count = ELEMENT_HEADER_SIZE + length + 1;
+
+    return (bytes_count + alignment - 1) / alignment * alignment;
+}
+
+PRIVATE inline SizeType element_storage_bytes(cString element)
+{
+    return storage_bytes_for_length(strlen(element));
+}
+
+// Bytes that will go back to the allocator once the list drops its reference to the payload
+PRIVATE SizeType element_released_bytes(cString element)
+{
+    if (load_count(get_reference_count_ptr(element)) != 1u)
+    {
+        return 0u;
+    }
+
+    SizeType* arena = element_arena(element);
+
+    if (arena == nullptr)
+    {
+        return element_allocation_bytes(element);
+    }
+
+    return load_count(&arena[0]) == 1u ? arena[1] : 0u;
+}
+
+// Leaves the payload in place if it is already packed or no longer fits, which only
+// happens when the list was modified between the steps of a compaction
+PRIVATE void move_element_to_arena(StringList list, const SizeType index, StringListCompaction* compaction)
+{
+    mString element = list[index];
+    SizeType* arena = (SizeType*)compaction->arena;
+    const SizeType storage_bytes = element_storage_bytes(element);
+
+    if (element_arena(element) == arena || compaction->used_bytes + storage_bytes > compaction->arena_bytes)
+    {
+        return;
+    }
+
+    mString packed_element = pack_element(arena, &compaction->used_bytes, element, strlen(element));
+    compaction->released_bytes += element_released_bytes(element);
+    release_element(element);
+    list[index] = packed_element;
+}
+
+// Stores an already allocated payload without copying it; the capacity must have been reserved
+PRIVATE inline void append_element(StringList list, mString element)
+{
+    SizeType* size_ptr = get_size_ptr(list);
+    list[*size_ptr] = element;
+    ++(*size_ptr);
+}
+
+PRIVATE void append_unique_sorted_element(StringList list, mString element)
+{
+    const SizeType size = impl_string_list_size(list);
+
+    if (size != 0u && strcmp(list[size - 1], element) == 0)
+    {
+        release_element(element);
+        return;
+    }
+
+    append_element(list, element);
+}
+
+PRIVATE void release_pointer_block(StringList* list_ptr)
+{
+    string_list_detail::release_pointer_block(list_ptr, default_allocator);
+}
+
+PRIVATE bool is_sorted_ascending(StringList list)
+{
+    const SizeType size = impl_string_list_size(list);
+
+    for (SizeType i = 1u; i < size; ++i)
+    {
+        if (strcmp(list[i - 1], list[i]) > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+PRIVATE void merge_set_operation(StringList first, StringList second, StringList result, SetOperation operation)
+{
+    const SizeType first_size = impl_string_list_size(first);
+    const SizeType second_size = impl_string_list_size(second);
+    const bool keep_first_only = operation != SetOperation::Intersection;
+    const bool keep_second_only = operation == SetOperation::Union;
+    const bool keep_common = operation != SetOperation::Difference;
+    SizeType i = 0u;
+    SizeType j = 0u;
+
+    while (i < first_size && j < second_size)
+    {
+        const int comparison = strcmp(first[i], second[j]);
+
+        if (comparison < 0)
+        {
+            keep_first_only ? append_unique_sorted_element(result, first[i]) : release_element(first[i]);
+            ++i;
+        }
+        else if (comparison > 0)
+        {
+            keep_second_only ? append_unique_sorted_element(result, second[j]) : release_element(second[j]);
+            ++j;
+        }
+        else
+        {
+            mString common = first[i];
+
+            for (++i; i < first_size && strcmp(first[i], common) == 0; ++i)
+            {
+                release_element(first[i]);
+            }
+
+            for (; j < second_size && strcmp(second[j], common) == 0; ++j)
+            {
+                release_element(second[j]);
+            }
+
+            keep_common ? append_unique_sorted_element(result, common) : release_element(common);
+        }
+    }
+
+    for (; i < first_size; ++i)
+    {
+        keep_first_only ? append_unique_sorted_element(result, first[i]) : release_element(first[i]);
+    }
+
+    for (; j < second_size; ++j)
+    {
+        keep_second_only ? append_unique_sorted_element(result, second[j]) : release_element(second[j]);
+    }
+}
+
+PRIVATE ErrorCode hashed_set_operation(StringList first, StringList second, StringList result, SetOperation operation)
+{
+    const SizeType first_size = impl_string_list_size(first);
+    const SizeType second_size = impl_string_list_size(second);
+    StringHashSet emitted;
+    StringHashSet second_members;
+
+    ErrorCode result_code = string_hash_set_init(&emitted, string_list_capacity(result));
+
+    if (result_code != ErrorCode::Success)
+    {
+        return result_code;
+    }
+
+    if (operation == SetOperation::Union)
+    {
+        for (SizeType i = 0u; i < first_size; ++i)
+        {
+            string_hash_set_insert(&emitted, first[i]) ? append_element(result, first[i]) : release_element(first[i]);
+        }
+
+        for (SizeType j = 0u; j < second_size; ++j)
+        {
+            string_hash_set_insert(&emitted, second[j]) ? append_element(result, second[j]) : release_element(second[j]);
+        }
+
+        string_hash_set_destroy(&emitted);
+        return ErrorCode::Success;
+    }
+
+    result_code = string_hash_set_init(&second_members, second_size);
+
+    if (result_code != ErrorCode::Success)
+    {
+        string_hash_set_destroy(&emitted);
+        return result_code;
+    }
+
+    for (SizeType j = 0u; j < second_size; ++j)
+    {
+        string_hash_set_insert(&second_members, second[j]);
+    }
+
+    const bool keep_members = operation == SetOperation::Intersection;
+
+    for (SizeType i = 0u; i < first_size; ++i)
+    {
+        const bool kept = string_hash_set_contains(&second_members, first[i]) == keep_members &&
+            string_hash_set_insert(&emitted, first[i]);
+
+        kept ? append_element(result, first[i]) : release_element(first[i]);
+    }
+
+    for (SizeType j = 0u; j < second_size; ++j)
+    {
+        release_element(second[j]);
+    }
+
+    string_hash_set_destroy(&second_members);
+    string_hash_set_destroy(&emitted);
+
+    return ErrorCode::Success;
+}
+
+// FNV-1a
+PRIVATE SizeType hash_string(cString str)
+{
+    SizeType hash = (SizeType)14695981039346656037ull;
+
+    for (; *str != '\0'; ++str)
+    {
+        hash ^= (unsigned char)*str;
+        hash *= (SizeType)1099511628211ull;
+    }
+
+    return hash;
+}
+
+PRIVATE ErrorCode string_hash_set_init(StringHashSet* set, const SizeType expected_count)
+{
+    SizeType capacity = 2u;
+
+    // Keeping the load factor at or below one half keeps the probe sequences short
+    while (capacity < (expected_count << 1))
+    {
+        capacity <<= 1;
+    }
+
+    set->slots = (cString*)default_allocator.allocate(capacity * sizeof(cString));
+    set->mask = capacity - 1;
+
+    if (set->slots == nullptr)
+    {
+        return ErrorCode::LackOfMemory;
+    }
+
+    memset(set->slots, 0, capacity * sizeof(cString));
+
+    return ErrorCode::Success;
+}
+
+PRIVATE void string_hash_set_destroy(StringHashSet* set)
+{
+    default_allocator.deallocate(set->slots, (set->mask + 1) * sizeof(cString));
+    set->slots = nullptr;
+}
+
+PRIVATE SizeType string_hash_set_find_slot(const StringHashSet* set, cString str)
+{
+    SizeType slot = hash_string(str) & set->mask;
+
+    while (set->slots[slot] != nullptr && strcmp(set->slots[slot], str) != 0)
+    {
+        slot = (slot + 1) & set->mask;
+    }
+
+    return slot;
+}
+
+PRIVATE bool string_hash_set_insert(StringHashSet* set, cString str)
+{
+    const SizeType slot = string_hash_set_find_slot(set, str);
+
+    if (set->slots[slot] != nullptr)
+    {
+        return false;
+    }
+
+    set->slots[slot] = str;
+    return true;
+}
+
+PRIVATE bool string_hash_set_contains(const StringHashSet* set, cString str)
+{
+    return set->slots[string_hash_set_find_slot(set, str)] != nullptr;
+}
+
+
+// Validators implementations
+
+PRIVATE inline ErrorCode validate_not_nullptr(const void* ptr)
+{
+    return ptr == nullptr
+         ? ErrorCode::NullPointerInput
+         : ErrorCode::Success;
+}
+
+PRIVATE inline ErrorCode validate_input_string_list_ptr(StringList* list_ptr)
+{
+    return validate_not_nullptr(list_ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_string_list(StringList list)
+{
+    return validate_not_nullptr(list);
+}
+
+PRIVATE inline ErrorCode validate_input_string(cString str)
+{
+    return validate_not_nullptr(str);
+}
+
+PRIVATE inline ErrorCode validate_input_bool_ptr(bool* ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_size_ptr(SizeType* ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_string_list_out_ptr(StringList* list_ptr)
+{
+    return validate_not_nullptr(list_ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_string_out_ptr(mString* ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_buffer(cString buffer)
+{
+    return validate_not_nullptr(buffer);
+}
+
+PRIVATE inline ErrorCode validate_input_counts_out_ptr(SizeType** ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE inline ErrorCode validate_input_fd(const int fd)
+{
+    return fd < 0
+         ? ErrorCode::InvalidArgument
+         : ErrorCode::Success;
+}
+
+PRIVATE inline ErrorCode validate_input_key_function(StringKeyFunction key_function)
+{
+    return key_function == nullptr
+         ? ErrorCode::NullPointerInput
+         : ErrorCode::Success;
+}
+
+PRIVATE inline ErrorCode validate_input_compaction_ptr(StringListCompaction* ptr)
+{
+    return validate_not_nullptr(ptr);
+}
+
+PRIVATE ErrorCode validate_input_set_operands(StringList* first, StringList* second, StringList* result)
+{
+    ErrorCode first_ptr_validation_error = validate_input_string_list_ptr(first);
+    ErrorCode second_ptr_validation_error = validate_input_string_list_ptr(second);
+    ErrorCode result_ptr_validation_error = validate_input_string_list_ptr(result);
+
+    if (first_ptr_validation_error != ErrorCode::Success)
+    {
+        return first_ptr_validation_error;
+    }
+
+    if (second_ptr_validation_error != ErrorCode::Success)
+    {
+        return second_ptr_validation_error;
+    }
+
+    if (result_ptr_validation_error != ErrorCode::Success)
+    {
+        return result_ptr_validation_error;
+    }
+
+    ErrorCode first_validation_error = validate_input_string_list(*first);
+    ErrorCode second_validation_error = validate_input_string_list(*second);
+
+    if (first_validation_error != ErrorCode::Success)
+    {
+        return first_validation_error;
+    }
+
+    if (second_validation_error != ErrorCode::Success)
+    {
+        return second_validation_error;
+    }
+
+    // Both operands are consumed, one list passed twice would be released twice
+    return first == second || *first == *second
+         ? ErrorCode::InvalidArgument
+         : ErrorCode::Success;
 }
\ No newline at end of file
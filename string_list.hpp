@@ -7,11 +7,29 @@ typedef const CharType* cString;
 typedef mString* StringList;
 typedef size_t SizeType;
 
+// Writes the sort key of str into key_buffer when it fits into buffer_size bytes and
+// returns the full key length either way, like strxfrm. Keys are compared bytewise.
+typedef SizeType (*StringKeyFunction)(cString str, mString key_buffer, SizeType buffer_size);
+
+// Progress of an incremental compaction, zero-initialise it before the first step
+struct StringListCompaction
+{
+	void* arena;
+	SizeType arena_bytes;
+	SizeType used_bytes;
+	SizeType cursor;
+	SizeType released_bytes;
+};
+
 enum class ErrorCode
 {
 	Success,
 	LackOfMemory,
 	NullPointerInput,
+	IndexOutOfRange,
+	InvalidArgument,
+	BufferTooSmall,
+	IoError,
 };
 
 ErrorCode string_list_init(StringList* list);
@@ -26,7 +44,63 @@ ErrorCode string_list_size(StringList list, SizeType* result);
 ErrorCode string_list_index_of(StringList list, cString str, SizeType* result);
 
 ErrorCode string_list_remove_duplicates(StringList* list);
+// Replaces in place, so after must not be longer than before
 ErrorCode string_list_replace_in_strings(StringList list, cString before, cString after);
 ErrorCode string_list_sort(StringList list);
 
+// Moves the k smallest strings to the front in sorted order, the rest is left unordered
+ErrorCode string_list_partial_sort(StringList list, SizeType k);
+// Moves the k largest strings to the front, largest first
+ErrorCode string_list_partial_sort_descending(StringList list, SizeType k);
+// Puts the string that would be at index n after sorting there, with no greater
+// string before it and no smaller string after it
+ErrorCode string_list_nth_element(StringList list, SizeType n);
+
+// The joined string is allocated with malloc and owned by the caller
+ErrorCode string_list_join(StringList list, cString separator, mString* result);
+// Writes the strings separated by separator, without a trailing one, using batched
+// writev calls that point straight at the stored payloads
+ErrorCode string_list_write_fd(StringList list, int fd, cString separator);
+
+// Stable sort by keys computed once per element
+ErrorCode string_list_sort_by(StringList list, StringKeyFunction key_function);
+SizeType string_key_case_insensitive(cString str, mString key_buffer, SizeType buffer_size);
+// Orders runs of digits by their numeric value, "file9" before "file10"
+SizeType string_key_natural(cString str, mString key_buffer, SizeType buffer_size);
+
+// Set operations consume both operands: their payloads are moved into *result
+// (or released) and *first, *second are reset to nullptr. When both operands are
+// sorted the result is produced by a linear merge and is sorted as well,
+// otherwise it keeps the order of first occurrence. Passing the same list as both
+// operands gives InvalidArgument.
+ErrorCode string_list_union(StringList* first, StringList* second, StringList* result);
+ErrorCode string_list_intersection(StringList* first, StringList* second, StringList* result);
+ErrorCode string_list_difference(StringList* first, StringList* second, StringList* result);
+
+// The clone shares the payloads of the source; a payload is copied only when
+// one of the lists modifies it through string_list_replace_in_strings. Reference
+// counts change atomically, so a clone can be used and destroyed on another thread
+// than its source, but one list must still not be used by two threads at once.
+// Every payload, cloned or not, carries a header of two SizeType words for its
+// reference count and its owner.
+ErrorCode string_list_clone(StringList list, StringList* result);
+
+// Splits length bytes of buffer at every delimiter, like str.split(delimiter) except
+// that an empty buffer gives an empty list. All tokens are copied into one block.
+ErrorCode string_list_from_split(cString buffer, SizeType length, CharType delimiter, StringList* result);
+
+// Produces every distinct string once, in order of first occurrence or by descending
+// count, and a malloc allocated array with the matching counts owned by the caller
+ErrorCode string_list_count_occurrences(StringList list, StringList* unique_list, SizeType** counts, bool sort_by_count);
+
+// Repacks all payloads into one contiguous block in list order and right-sizes the
+// pointer array. The step version works for about time_budget_us microseconds per
+// call and sets *finished and *reclaimed_bytes once the compaction is complete;
+// the list should not be modified until then.
+ErrorCode string_list_compact(StringList* list, SizeType* reclaimed_bytes);
+ErrorCode string_list_compact_step(StringList* list, StringListCompaction* compaction, SizeType time_budget_us, SizeType* reclaimed_bytes, bool* finished);
+// Gives up an unfinished compaction, needed before the list is destroyed or dropped
+// mid-way. A list that is still alive stays valid, partly packed.
+ErrorCode string_list_compact_abort(StringListCompaction* compaction);
+
 #endif // !STRING_LIST_HPP_
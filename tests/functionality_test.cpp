@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "../string_list.hpp"
+#include "../compressed_string_list.hpp"
+#include "../basic_string_list.hpp"
+#include <thread>
+#include <vector>
 
 class StringListFunctionalityTest : public ::testing::Test
 {
@@ -232,6 +236,887 @@ TEST_F(StringListFunctionalityTest, Sort)
     EXPECT_TRUE(is_sorted(list));
 }
 
+static StringList make_list(std::initializer_list<cString> strings)
+{
+    StringList result = nullptr;
+    string_list_init(&result);
+
+    for (cString str : strings)
+    {
+        string_list_add(&result, str);
+    }
+
+    return result;
+}
+
+static void expect_list_equals(StringList list, std::initializer_list<cString> expected)
+{
+    ASSERT_EQ(size_of_list(list), expected.size());
+
+    SizeType i = 0u;
+    for (cString str : expected)
+    {
+        EXPECT_STREQ(list[i], str);
+        ++i;
+    }
+}
+
+template <class AllocatorPolicy>
+static void expect_list_equals(const BasicStringList<AllocatorPolicy>& list, std::initializer_list<cString> expected)
+{
+    ASSERT_EQ(list.size(), expected.size());
+
+    const cString* strings = list.data();
+    SizeType i = 0u;
+    for (cString str : expected)
+    {
+        EXPECT_STREQ(strings[i], str);
+        ++i;
+    }
+}
+
+TEST(StringListSetOperationsTest, UnionOfUnsortedKeepsFirstOccurrenceOrder)
+{
+    StringList first = make_list({ "b", "a", "b", "c" });
+    StringList second = make_list({ "d", "a", "e", "d" });
+    StringList result = nullptr;
+
+    EXPECT_EQ(string_list_union(&first, &second, &result), ErrorCode::Success);
+    EXPECT_TRUE(first == nullptr);
+    EXPECT_TRUE(second == nullptr);
+    expect_list_equals(result, { "b", "a", "c", "d", "e" });
+
+    string_list_destroy(&result);
+}
+
+TEST(StringListSetOperationsTest, UnionOfSortedIsMerged)
+{
+    StringList first = make_list({ "a", "b", "b", "d" });
+    StringList second = make_list({ "b", "c", "d", "e" });
+    StringList result = nullptr;
+
+    EXPECT_EQ(string_list_union(&first, &second, &result), ErrorCode::Success);
+    expect_list_equals(result, { "a", "b", "c", "d", "e" });
+
+    string_list_destroy(&result);
+}
+
+TEST(StringListSetOperationsTest, Intersection)
+{
+    StringList first = make_list({ "c", "a", "b", "a", "x" });
+    StringList second = make_list({ "a", "y", "c", "c" });
+    StringList result = nullptr;
+
+    EXPECT_EQ(string_list_intersection(&first, &second, &result), ErrorCode::Success);
+    expect_list_equals(result, { "c", "a" });
+    string_list_destroy(&result);
+
+    first = make_list({ "a", "a", "b", "c", "d" });
+    second = make_list({ "a", "c", "c", "e" });
+
+    EXPECT_EQ(string_list_intersection(&first, &second, &result), ErrorCode::Success);
+    expect_list_equals(result, { "a", "c" });
+    string_list_destroy(&result);
+}
+
+TEST(StringListSetOperationsTest, Difference)
+{
+    StringList first = make_list({ "c", "a", "b", "a", "x" });
+    StringList second = make_list({ "a", "y", "c" });
+    StringList result = nullptr;
+
+    EXPECT_EQ(string_list_difference(&first, &second, &result), ErrorCode::Success);
+    expect_list_equals(result, { "b", "x" });
+    string_list_destroy(&result);
+
+    first = make_list({ "a", "a", "b", "b", "c", "d" });
+    second = make_list({ "a", "c", "e" });
+
+    EXPECT_EQ(string_list_difference(&first, &second, &result), ErrorCode::Success);
+    expect_list_equals(result, { "b", "d" });
+    string_list_destroy(&result);
+}
+
+TEST(StringListSetOperationsTest, SameListAsBothOperandsIsRejected)
+{
+    using SetOperationFunction = ErrorCode(*)(StringList*, StringList*, StringList*);
+    const SetOperationFunction operations[] { string_list_union, string_list_intersection, string_list_difference };
+    StringList list = make_list({ "b", "a", "c" });
+    StringList alias = list;
+    StringList result = nullptr;
+
+    for (SetOperationFunction operation : operations)
+    {
+        EXPECT_EQ(operation(&list, &list, &result) , ErrorCode::InvalidArgument);
+        EXPECT_EQ(operation(&list, &alias, &result), ErrorCode::InvalidArgument);
+        EXPECT_EQ(result, nullptr);
+        expect_list_equals(list, { "b", "a", "c" });
+    }
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCloneTest, CloneSharesContents)
+{
+    StringList source = make_list({ "abc", "bcd", "cde" });
+    StringList clone = nullptr;
+
+    EXPECT_EQ(string_list_clone(source, &clone), ErrorCode::Success);
+    EXPECT_TRUE(clone != source);
+    expect_list_equals(clone, { "abc", "bcd", "cde" });
+
+    string_list_destroy(&source);
+    expect_list_equals(clone, { "abc", "bcd", "cde" });
+
+    string_list_destroy(&clone);
+}
+
+TEST(StringListCloneTest, ModificationsDoNotLeakBetweenClones)
+{
+    StringList source = make_list({ "abab", "cc", "ab" });
+    StringList clone = nullptr;
+    string_list_clone(source, &clone);
+
+    string_list_replace_in_strings(clone, "ab", "ba");
+    string_list_remove(clone, "cc");
+    string_list_add(&clone, "dd");
+    string_list_sort(source);
+
+    expect_list_equals(source, { "ab", "abab", "cc" });
+    expect_list_equals(clone, { "baba", "ba", "dd" });
+
+    string_list_replace_in_strings(source, "c", "d");
+    expect_list_equals(source, { "ab", "abab", "dd" });
+    expect_list_equals(clone, { "baba", "ba", "dd" });
+
+    string_list_destroy(&source);
+    string_list_destroy(&clone);
+}
+
+TEST(StringListCloneTest, EmptyPatternKeepsPayloadsShared)
+{
+    StringList source = make_list({ "ab", "cd" });
+    StringList clone = nullptr;
+    string_list_clone(source, &clone);
+
+    EXPECT_EQ(string_list_replace_in_strings(clone, "", "z"), ErrorCode::Success);
+    expect_list_equals(clone, { "ab", "cd" });
+    EXPECT_EQ(clone[0], source[0]);
+    EXPECT_EQ(clone[1], source[1]);
+
+    string_list_destroy(&source);
+    string_list_destroy(&clone);
+}
+
+TEST(StringListCloneTest, ClonesCanBeReleasedOnOtherThreads)
+{
+    StringList source = nullptr;
+    string_list_init(&source);
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        string_list_add(&source, std::to_string(i).c_str());
+    }
+
+    std::vector<std::thread> threads;
+
+    for (SizeType i = 0u; i < 4u; ++i)
+    {
+        StringList clone = nullptr;
+        string_list_clone(source, &clone);
+
+        threads.emplace_back([clone]() mutable
+        {
+            for (SizeType j = 0u; j < 100u; ++j)
+            {
+                StringList copy = nullptr;
+                string_list_clone(clone, &copy);
+                string_list_destroy(&copy);
+            }
+
+            string_list_destroy(&clone);
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    SizeType index = 0u;
+    string_list_index_of(source, "999", &index);
+    EXPECT_EQ(index, 999u);
+    string_list_destroy(&source);
+}
+
+TEST(StringListCompactTest, CompactPacksPayloadsInListOrder)
+{
+    StringList list = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 100u; ++i)
+    {
+        string_list_add(&list, std::to_string(i).c_str());
+    }
+
+    for (SizeType i = 0u; i < 100u; i += 3)
+    {
+        string_list_remove(list, std::to_string(i).c_str());
+    }
+
+    string_list_replace_in_strings(list, "1", "");
+
+    std::vector<std::string> expected(list, list + size_of_list(list));
+
+    SizeType reclaimed_bytes = 0u;
+    EXPECT_EQ(string_list_compact(&list, &reclaimed_bytes), ErrorCode::Success);
+    EXPECT_GT(reclaimed_bytes, 0u);
+
+    ASSERT_EQ(size_of_list(list), expected.size());
+    for (SizeType i = 0u; i < size_of_list(list); ++i)
+    {
+        EXPECT_STREQ(list[i], expected[i].c_str());
+
+        if (i > 0u)
+        {
+            EXPECT_LT(list[i - 1], list[i]);
+            EXPECT_LT(list[i] - list[i - 1], 64);
+        }
+    }
+
+    string_list_add(&list, "after");
+    string_list_remove(list, "2");
+    EXPECT_EQ(string_list_compact(&list, &reclaimed_bytes), ErrorCode::Success);
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCompactTest, CompactStepRespectsTimeBudget)
+{
+    StringList list = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        string_list_add(&list, std::to_string(i).c_str());
+    }
+
+    StringListCompaction compaction {};
+    SizeType reclaimed_bytes = 0u;
+    bool finished = false;
+    SizeType steps_count = 0u;
+
+    while (!finished)
+    {
+        EXPECT_EQ(string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, &finished), ErrorCode::Success);
+        ++steps_count;
+    }
+
+    EXPECT_GT(steps_count, 1u);
+    ASSERT_EQ(size_of_list(list), 1000u);
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        EXPECT_STREQ(list[i], std::to_string(i).c_str());
+    }
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCompactTest, AbortReleasesTheArenaOfAnAbandonedCompaction)
+{
+    StringList list = nullptr;
+    StringList kept = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        string_list_add(&list, std::to_string(i).c_str());
+    }
+
+    StringListCompaction compaction {};
+    SizeType reclaimed_bytes = 0u;
+    bool finished = false;
+
+    while (compaction.arena == nullptr || compaction.cursor < 500u)
+    {
+        string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, &finished);
+    }
+
+    ASSERT_FALSE(finished);
+    string_list_clone(list, &kept);
+    string_list_destroy(&list);
+    EXPECT_EQ(string_list_compact_abort(&compaction), ErrorCode::Success);
+    EXPECT_EQ(compaction.arena, nullptr);
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        EXPECT_STREQ(kept[i], std::to_string(i).c_str());
+    }
+
+    string_list_destroy(&kept);
+}
+
+TEST(StringListCompactTest, StepEndsAfterAllocatingTheArenaOnceTheBudgetIsSpent)
+{
+    StringList list = make_list({ "a", "b", "c" });
+    StringListCompaction compaction {};
+    SizeType reclaimed_bytes = 0u;
+    bool finished = false;
+
+    EXPECT_EQ(string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, &finished), ErrorCode::Success);
+    EXPECT_FALSE(finished);
+    EXPECT_NE(compaction.arena, nullptr);
+    EXPECT_EQ(compaction.cursor, 0u);
+
+    EXPECT_EQ(string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, &finished), ErrorCode::Success);
+    EXPECT_TRUE(finished);
+    expect_list_equals(list, { "a", "b", "c" });
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCompactTest, HugeTimeBudgetFinishesInOneStep)
+{
+    StringList list = make_list({ "a", "b", "c" });
+    StringListCompaction compaction {};
+    SizeType reclaimed_bytes = 0u;
+    bool finished = false;
+
+    EXPECT_EQ(string_list_compact_step(&list, &compaction, (SizeType)(-2), &reclaimed_bytes, &finished), ErrorCode::Success);
+    EXPECT_TRUE(finished);
+    expect_list_equals(list, { "a", "b", "c" });
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCompactTest, CompactLeavesClonesIntact)
+{
+    StringList list = make_list({ "abc", "bcd", "cde" });
+    StringList clone = nullptr;
+    string_list_clone(list, &clone);
+
+    SizeType reclaimed_bytes = 0u;
+    string_list_compact(&list, &reclaimed_bytes);
+    string_list_replace_in_strings(list, "c", "x");
+
+    expect_list_equals(list, { "abx", "bxd", "xde" });
+    expect_list_equals(clone, { "abc", "bcd", "cde" });
+
+    string_list_compact(&clone, &reclaimed_bytes);
+    string_list_destroy(&list);
+    expect_list_equals(clone, { "abc", "bcd", "cde" });
+
+    string_list_destroy(&clone);
+}
+
+TEST_F(StringListFunctionalityTest, PartialSort)
+{
+    for (SizeType i = 0u; i < 50u; ++i)
+    {
+        string_list_add(&list, std::to_string((i * 37u) % 50u + 10u).c_str());
+    }
+
+    EXPECT_EQ(string_list_partial_sort(list, 5u), ErrorCode::Success);
+
+    for (SizeType i = 0u; i < 5u; ++i)
+    {
+        EXPECT_STREQ(list[i], std::to_string(i + 10u).c_str());
+    }
+
+    EXPECT_EQ(string_list_partial_sort(list, 100u), ErrorCode::Success);
+    EXPECT_TRUE(is_sorted(list));
+}
+
+TEST_F(StringListFunctionalityTest, PartialSortDescending)
+{
+    for (SizeType i = 0u; i < 50u; ++i)
+    {
+        string_list_add(&list, std::to_string((i * 37u) % 50u + 10u).c_str());
+    }
+
+    EXPECT_EQ(string_list_partial_sort_descending(list, 5u), ErrorCode::Success);
+
+    for (SizeType i = 0u; i < 5u; ++i)
+    {
+        EXPECT_STREQ(list[i], std::to_string(59u - i).c_str());
+    }
+
+    EXPECT_EQ(string_list_partial_sort_descending(list, 100u), ErrorCode::Success);
+
+    for (SizeType i = 1u; i < 50u; ++i)
+    {
+        EXPECT_GE(strcmp(list[i - 1], list[i]), 0);
+    }
+}
+
+TEST_F(StringListFunctionalityTest, NthElement)
+{
+    for (SizeType i = 0u; i < 50u; ++i)
+    {
+        string_list_add(&list, std::to_string((i * 37u) % 50u + 10u).c_str());
+    }
+
+    EXPECT_EQ(string_list_nth_element(list, 25u), ErrorCode::Success);
+    EXPECT_STREQ(list[25], "35");
+
+    for (SizeType i = 0u; i < 50u; ++i)
+    {
+        EXPECT_EQ(strcmp(list[i], list[25]) < 0, i < 25u);
+    }
+
+    EXPECT_EQ(string_list_nth_element(list, 50u), ErrorCode::IndexOutOfRange);
+}
+
+static SizeType reversed_key(cString str, mString key_buffer, SizeType buffer_size)
+{
+    const SizeType length = strlen(str);
+
+    for (SizeType i = 0u; i < length && i < buffer_size; ++i)
+    {
+        key_buffer[i] = str[length - 1 - i];
+    }
+
+    return length;
+}
+
+TEST(StringListSortByTest, SortByCustomKey)
+{
+    StringList list = make_list({ "ab", "ca", "bc", "a_very_long_string_that_does_not_fit_into_the_initial_estimate_of_the_keys_buffer_z" });
+
+    EXPECT_EQ(string_list_sort_by(list, reversed_key), ErrorCode::Success);
+    expect_list_equals(list, { "ca", "ab", "bc", "a_very_long_string_that_does_not_fit_into_the_initial_estimate_of_the_keys_buffer_z" });
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListSortByTest, SortCaseInsensitive)
+{
+    StringList list = make_list({ "b", "A", "C", "a", "B" });
+
+    EXPECT_EQ(string_list_sort_by(list, string_key_case_insensitive), ErrorCode::Success);
+    expect_list_equals(list, { "A", "a", "b", "B", "C" });
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListSortByTest, SortNatural)
+{
+    StringList list = make_list({ "file10", "file9", "file-", "file", "file2b", "file02a", "file1", "x" });
+
+    EXPECT_EQ(string_list_sort_by(list, string_key_natural), ErrorCode::Success);
+    expect_list_equals(list, { "file", "file-", "file1", "file02a", "file2b", "file9", "file10", "x" });
+
+    string_list_destroy(&list);
+}
+
+static std::string path_at(SizeType i)
+{
+    return "/srv/data/shard_" + std::to_string(i / 100u) + "/files/item_" + std::to_string(i);
+}
+
+TEST(CompressedStringListTest, GetDecodesEveryEntry)
+{
+    StringList list = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        string_list_add(&list, path_at(i).c_str());
+    }
+
+    string_list_sort(list);
+
+    CompressedStringList compressed = nullptr;
+    EXPECT_EQ(compressed_string_list_build(list, 32u, &compressed), ErrorCode::Success);
+
+    SizeType size = 0u;
+    compressed_string_list_size(compressed, &size);
+    EXPECT_EQ(size, 1000u);
+
+    SizeType storage_bytes = 0u;
+    compressed_string_list_storage_bytes(compressed, &storage_bytes);
+    EXPECT_LT(storage_bytes, 1000u * path_at(999u).size() / 3u);
+
+    CharType buffer[64];
+    SizeType length = 0u;
+    const SizeType indices[] { 0u, 1u, 500u, 31u, 32u, 33u, 999u, 998u, 0u };
+
+    for (SizeType i = 0u; i < 1000u; ++i)
+    {
+        EXPECT_EQ(compressed_string_list_get(compressed, i, buffer, sizeof(buffer), &length), ErrorCode::Success);
+        EXPECT_STREQ(buffer, list[i]);
+        EXPECT_EQ(length, strlen(list[i]));
+    }
+
+    for (SizeType index : indices)
+    {
+        compressed_string_list_get(compressed, index, buffer, sizeof(buffer), &length);
+        EXPECT_STREQ(buffer, list[index]);
+    }
+
+    EXPECT_EQ(compressed_string_list_get(compressed, 1000u, buffer, sizeof(buffer), &length), ErrorCode::IndexOutOfRange);
+    EXPECT_EQ(compressed_string_list_get(compressed, 0u, buffer, 4u, &length), ErrorCode::BufferTooSmall);
+    EXPECT_EQ(length, strlen(list[0]));
+
+    compressed_string_list_destroy(&compressed);
+    EXPECT_TRUE(compressed == nullptr);
+    string_list_destroy(&list);
+}
+
+TEST(CompressedStringListTest, IndexOfFindsFirstOccurrence)
+{
+    StringList list = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 40u; ++i)
+    {
+        string_list_add(&list, "a");
+    }
+
+    for (SizeType i = 0u; i < 40u; ++i)
+    {
+        string_list_add(&list, ("b" + std::to_string(i + 10u)).c_str());
+    }
+
+    CompressedStringList compressed = nullptr;
+    ASSERT_EQ(compressed_string_list_build(list, 16u, &compressed), ErrorCode::Success);
+
+    SizeType index = 0u;
+    compressed_string_list_index_of(compressed, "a", &index);
+    EXPECT_EQ(index, 0u);
+
+    for (SizeType i = 0u; i < 40u; ++i)
+    {
+        compressed_string_list_index_of(compressed, ("b" + std::to_string(i + 10u)).c_str(), &index);
+        EXPECT_EQ(index, i + 40u);
+    }
+
+    compressed_string_list_index_of(compressed, "b", &index);
+    EXPECT_EQ(index, (SizeType)(-1));
+    compressed_string_list_index_of(compressed, "c", &index);
+    EXPECT_EQ(index, (SizeType)(-1));
+    compressed_string_list_index_of(compressed, "", &index);
+    EXPECT_EQ(index, (SizeType)(-1));
+
+    compressed_string_list_destroy(&compressed);
+    string_list_destroy(&list);
+}
+
+TEST(CompressedStringListTest, BuildRejectsUnsortedInput)
+{
+    StringList list = make_list({ "b", "a" });
+    CompressedStringList compressed = nullptr;
+
+    EXPECT_EQ(compressed_string_list_build(list, 16u, &compressed), ErrorCode::InvalidArgument);
+    EXPECT_EQ(compressed_string_list_build(list, 8u, &compressed), ErrorCode::InvalidArgument);
+    EXPECT_TRUE(compressed == nullptr);
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListOutputTest, Join)
+{
+    StringList list = make_list({ "a", "bc", "", "def" });
+    mString joined = nullptr;
+
+    EXPECT_EQ(string_list_join(list, ", ", &joined), ErrorCode::Success);
+    EXPECT_STREQ(joined, "a, bc, , def");
+    free(joined);
+
+    EXPECT_EQ(string_list_join(list, "", &joined), ErrorCode::Success);
+    EXPECT_STREQ(joined, "abcdef");
+    free(joined);
+
+    string_list_destroy(&list);
+    string_list_init(&list);
+
+    EXPECT_EQ(string_list_join(list, ", ", &joined), ErrorCode::Success);
+    EXPECT_STREQ(joined, "");
+    free(joined);
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListOutputTest, WriteFdMatchesJoin)
+{
+    StringList list = nullptr;
+    string_list_init(&list);
+
+    for (SizeType i = 0u; i < 3000u; ++i)
+    {
+        string_list_add(&list, std::to_string(i).c_str());
+    }
+
+    mString joined = nullptr;
+    string_list_join(list, "\n", &joined);
+
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != nullptr);
+    EXPECT_EQ(string_list_write_fd(list, fileno(file), "\n"), ErrorCode::Success);
+
+    const SizeType joined_length = strlen(joined);
+    std::string written(joined_length + 1, '\0');
+    rewind(file);
+    EXPECT_EQ(fread(&written[0], 1, written.size(), file), joined_length);
+    written.resize(joined_length);
+    EXPECT_STREQ(written.c_str(), joined);
+
+    EXPECT_EQ(string_list_write_fd(list, -1, "\n"), ErrorCode::InvalidArgument);
+
+    fclose(file);
+    free(joined);
+    string_list_destroy(&list);
+}
+
+TEST(StringListOutputTest, WriteFdSkipsEmptyStrings)
+{
+    StringList list = make_list({ "", "a", "", "b", "" });
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != nullptr);
+
+    EXPECT_EQ(string_list_write_fd(list, fileno(file), ""), ErrorCode::Success);
+
+    char written[8] = {};
+    rewind(file);
+    EXPECT_EQ(fread(written, 1, sizeof(written), file), 2u);
+    EXPECT_STREQ(written, "ab");
+
+    fclose(file);
+    string_list_destroy(&list);
+}
+
+TEST(StringListSplitTest, SplitKeepsEmptyTokens)
+{
+    const cString buffer = "a,bb,,ccc,";
+    StringList list = nullptr;
+
+    EXPECT_EQ(string_list_from_split(buffer, strlen(buffer), ',', &list), ErrorCode::Success);
+    expect_list_equals(list, { "a", "bb", "", "ccc", "" });
+    string_list_destroy(&list);
+
+    EXPECT_EQ(string_list_from_split(buffer, 0u, ',', &list), ErrorCode::Success);
+    EXPECT_EQ(size_of_list(list), 0u);
+    string_list_destroy(&list);
+
+    EXPECT_EQ(string_list_from_split(buffer, 4u, ';', &list), ErrorCode::Success);
+    expect_list_equals(list, { "a,bb" });
+    string_list_destroy(&list);
+}
+
+TEST(StringListSplitTest, SplitLongBufferMatchesScalarSplit)
+{
+    std::string buffer;
+    std::vector<std::string> expected;
+
+    for (SizeType i = 0u; i < 500u; ++i)
+    {
+        expected.push_back(std::string((i * 7u) % 45u, (CharType)('a' + i % 26u)));
+        buffer += expected.back();
+        buffer += '\t';
+    }
+
+    expected.push_back("tail");
+    buffer += expected.back();
+
+    StringList list = nullptr;
+    EXPECT_EQ(string_list_from_split(buffer.data(), buffer.size(), '\t', &list), ErrorCode::Success);
+    ASSERT_EQ(size_of_list(list), expected.size());
+
+    for (SizeType i = 0u; i < expected.size(); ++i)
+    {
+        EXPECT_STREQ(list[i], expected[i].c_str());
+    }
+
+    string_list_replace_in_strings(list, "a", "b");
+    string_list_remove(list, "tail");
+    string_list_add(&list, "added");
+    SizeType reclaimed_bytes = 0u;
+    string_list_compact(&list, &reclaimed_bytes);
+    EXPECT_STREQ(list[size_of_list(list) - 1], "added");
+
+    string_list_destroy(&list);
+}
+
+TEST(StringListCountOccurrencesTest, CountsInFirstOccurrenceOrder)
+{
+    StringList list = make_list({ "b", "a", "c", "a", "b", "a", "d" });
+    StringList unique = nullptr;
+    SizeType* counts = nullptr;
+
+    EXPECT_EQ(string_list_count_occurrences(list, &unique, &counts, false), ErrorCode::Success);
+    expect_list_equals(unique, { "b", "a", "c", "d" });
+    EXPECT_EQ(counts[0], 2u);
+    EXPECT_EQ(counts[1], 3u);
+    EXPECT_EQ(counts[2], 1u);
+    EXPECT_EQ(counts[3], 1u);
+
+    string_list_destroy(&list);
+    expect_list_equals(unique, { "b", "a", "c", "d" });
+
+    free(counts);
+    string_list_destroy(&unique);
+}
+
+TEST(StringListCountOccurrencesTest, CountsSortedByCount)
+{
+    StringList list = make_list({ "b", "a", "c", "a", "b", "a", "d", "c", "c", "c" });
+    StringList unique = nullptr;
+    SizeType* counts = nullptr;
+
+    EXPECT_EQ(string_list_count_occurrences(list, &unique, &counts, true), ErrorCode::Success);
+    expect_list_equals(unique, { "c", "a", "b", "d" });
+    EXPECT_EQ(counts[0], 4u);
+    EXPECT_EQ(counts[1], 3u);
+    EXPECT_EQ(counts[2], 2u);
+    EXPECT_EQ(counts[3], 1u);
+
+    free(counts);
+    string_list_destroy(&unique);
+    string_list_destroy(&list);
+}
+
+struct CountingAllocator
+{
+    SizeType* allocated_bytes;
+    SizeType* deallocated_bytes;
+    MallocAllocator allocator;
+
+    void* allocate(SizeType bytes_count)
+    {
+        *allocated_bytes += bytes_count;
+        return allocator.allocate(bytes_count);
+    }
+
+    void* reallocate(void* block, SizeType old_bytes_count, SizeType new_bytes_count)
+    {
+        *allocated_bytes += new_bytes_count;
+        *deallocated_bytes += old_bytes_count;
+        return allocator.reallocate(block, old_bytes_count, new_bytes_count);
+    }
+
+    void deallocate(void* block, SizeType bytes_count)
+    {
+        *deallocated_bytes += bytes_count;
+        allocator.deallocate(block, bytes_count);
+    }
+};
+
+TEST(BasicStringListTest, DefaultPolicyWorksWithStringListFunctions)
+{
+    BasicStringList<> list;
+    EXPECT_EQ(sizeof(list), sizeof(StringList));
+    EXPECT_EQ(list.add("b"), ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.init(), ErrorCode::Success);
+
+    EXPECT_EQ(list.add("c"), ErrorCode::Success);
+    EXPECT_EQ(list.add("a"), ErrorCode::Success);
+    EXPECT_EQ(list.add("b"), ErrorCode::Success);
+    EXPECT_EQ(list.add("a"), ErrorCode::Success);
+    EXPECT_EQ(list.remove("a"), ErrorCode::Success);
+    EXPECT_EQ(list.size(), 2u);
+
+    EXPECT_EQ(list.sort(), ErrorCode::Success);
+    expect_list_equals(list, { "b", "c" });
+
+    mString joined = nullptr;
+    EXPECT_EQ(list.join(",", &joined), ErrorCode::Success);
+    EXPECT_STREQ(joined, "b,c");
+    free(joined);
+}
+
+TEST(BasicStringListTest, EveryBlockGoesThroughThePolicy)
+{
+    SizeType allocated_bytes = 0u;
+    SizeType deallocated_bytes = 0u;
+
+    {
+        BasicStringList<CountingAllocator> list(CountingAllocator { &allocated_bytes, &deallocated_bytes, {} });
+        list.init();
+
+        for (SizeType i = 0u; i < 100u; ++i)
+        {
+            list.add(std::to_string(i).c_str());
+        }
+
+        list.remove("42");
+        EXPECT_EQ(list.size(), 99u);
+        EXPECT_GT(allocated_bytes, deallocated_bytes);
+    }
+
+    EXPECT_EQ(allocated_bytes, deallocated_bytes);
+}
+
+TEST(BasicStringListTest, MutatingOperationsReleaseThroughThePolicy)
+{
+    SizeType allocated_bytes = 0u;
+    SizeType deallocated_bytes = 0u;
+
+    {
+        BasicStringList<CountingAllocator> list(CountingAllocator { &allocated_bytes, &deallocated_bytes, {} });
+        list.init();
+
+        for (cString str : { "abab", "cd", "abab", "abab", "ab" })
+        {
+            list.add(str);
+        }
+
+        const SizeType deallocated_before = deallocated_bytes;
+        EXPECT_EQ(list.remove_duplicates(), ErrorCode::Success);
+        EXPECT_GT(deallocated_bytes, deallocated_before);
+        EXPECT_EQ(list.replace_in_strings("ab", "x"), ErrorCode::Success);
+        EXPECT_EQ(list.sort(), ErrorCode::Success);
+
+        SizeType index = 0u;
+        EXPECT_EQ(list.index_of("xx", &index), ErrorCode::Success);
+        EXPECT_EQ(index, 2u);
+        expect_list_equals(list, { "cd", "x", "xx" });
+    }
+
+    EXPECT_EQ(allocated_bytes, deallocated_bytes);
+}
+
+TEST(BasicStringListTest, MonotonicPolicyUsesTheCallerBuffer)
+{
+    alignas(16) CharType buffer[1024];
+    BasicStringList<MonotonicAllocator> list(MonotonicAllocator(buffer, sizeof(buffer)));
+    list.init();
+
+    ErrorCode result_code = ErrorCode::Success;
+    SizeType added_count = 0u;
+
+    while (result_code == ErrorCode::Success)
+    {
+        result_code = list.add("monotonic");
+        added_count += result_code == ErrorCode::Success;
+    }
+
+    EXPECT_EQ(result_code, ErrorCode::LackOfMemory);
+    EXPECT_GT(added_count, 10u);
+    EXPECT_EQ(list.size(), added_count);
+    EXPECT_LE(list.get_allocator().get_used_bytes(), sizeof(buffer));
+
+    for (SizeType i = 0u; i < list.size(); ++i)
+    {
+        EXPECT_GE(list[i], buffer);
+        EXPECT_LT(list[i], buffer + sizeof(buffer));
+        EXPECT_STREQ(list[i], "monotonic");
+    }
+}
+
+#ifdef STRING_LIST_HAS_PMR
+
+TEST(BasicStringListTest, PmrPolicyUsesTheResource)
+{
+    std::pmr::monotonic_buffer_resource resource;
+    BasicStringList<PmrAllocator> list { PmrAllocator(&resource) };
+    list.init();
+    list.add("pmr");
+
+    EXPECT_STREQ(list[0], "pmr");
+}
+
+#endif
+
 int main(int argc, char** argv) 
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,700 @@
+// Scaling and memory stress harness. Runs every public operation on large synthetic
+// lists, reports time, allocation count and RSS growth per operation and compares them
+// against a baseline file:
+//
+//   stress [--counts 100000,1000000] [--seed N] [--repeat N] [--baseline FILE]
+//          [--threshold PERCENT] [--time-threshold PERCENT] [--time-floor-us N]
+//          [--rss-slack-kib N] [--write-baseline FILE]
+//
+// The strings only depend on the seed and the count, so apart from the timings every
+// run is reproducible. Exits with 1 when the allocation count or the RSS growth of an
+// operation exceeds its baseline by more than --threshold, or when a result has no
+// baseline entry. Timings vary with the machine and its load, so they are compared
+// only when --time-threshold is given. --write-baseline replaces the file with the
+// results of this run, so record every count in one run.
+#include "../string_list.hpp"
+#include "../compressed_string_list.hpp"
+#include "../basic_string_list.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <fcntl.h>
+#include <io.h>
+#include <malloc.h>
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifndef STRING_LIST_COUNT_ALLOCATIONS
+#error The stress harness needs STRING_LIST_COUNT_ALLOCATIONS to count allocations
+#endif
+
+static const SizeType DEFAULT_COUNT = 100000u;
+static const unsigned long long DEFAULT_SEED = 20240601ull;
+static const SizeType DEFAULT_REPEAT = 3u;
+static const double DEFAULT_THRESHOLD_PERCENT = 25.0;
+static const SizeType DEFAULT_TIME_FLOOR_US = 10000u;
+static const double TIME_NOT_COMPARED = -1.0;
+static const SizeType DEFAULT_RSS_SLACK_KIB = 1024u;
+
+static const SizeType LINEAR_LOOKUP_COUNT = 16u;
+static const SizeType BINARY_LOOKUP_COUNT = 10000u;
+static const SizeType PARTIAL_SORT_COUNT = 1000u;
+static const SizeType COMPACTION_STEP_BUDGET_US = 1000u;
+static const SizeType COMPRESSED_BLOCK_SIZE = 32u;
+static const SizeType MIN_STRING_LENGTH = 4u;
+static const SizeType MAX_STRING_LENGTH = 20u;
+static const SizeType UNLIMITED_COUNT = (SizeType)(-1);
+static const SizeType QUADRATIC_MAX_COUNT = 100000u;
+
+struct Metrics
+{
+    SizeType time_us;
+    SizeType allocations;
+    SizeType peak_rss_delta_kib;
+};
+
+// Read-only data shared by all operations of one count
+struct Workload
+{
+    SizeType count;
+    std::vector<CharType> text;
+    std::vector<SizeType> lookups;
+    StringList source;
+    StringList sorted;
+    StringList other;
+    StringList other_sorted;
+};
+
+// Whatever an operation prepares, produces or has to release afterwards
+struct OperationState
+{
+    StringList first;
+    StringList second;
+    StringList result;
+    mString buffer;
+    SizeType* counts;
+    CompressedStringList compressed;
+    int fd;
+};
+
+struct Operation
+{
+    const char* name;
+    // Larger lists are skipped, quadratic operations would not finish on them
+    SizeType max_count;
+    void (*prepare)(Workload& workload, OperationState& state);
+    ErrorCode (*run)(Workload& workload, OperationState& state);
+};
+
+// splitmix64, small and identical on every platform
+static unsigned long long next_random(unsigned long long* state)
+{
+    unsigned long long value = (*state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+    return value ^ (value >> 31);
+}
+
+// Every key maps to one string, so drawing keys from a range half the size of the
+// list gives duplicates. Mixed case and digits exercise the sort key functions.
+static void append_synthetic_string(std::vector<CharType>& text, unsigned long long key)
+{
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGH0123456789";
+    unsigned long long state = key;
+    const SizeType length = MIN_STRING_LENGTH + next_random(&state) % (MAX_STRING_LENGTH - MIN_STRING_LENGTH + 1);
+
+    for (SizeType i = 0u; i < length; ++i)
+    {
+        text.push_back(alphabet[next_random(&state) % (sizeof(alphabet) - 1)]);
+    }
+
+    text.push_back('\0');
+}
+
+static std::vector<CharType> generate_text(SizeType count, unsigned long long seed)
+{
+    std::vector<CharType> text;
+    text.reserve(count * ((MIN_STRING_LENGTH + MAX_STRING_LENGTH) / 2 + 1));
+    const unsigned long long distinct_count = count / 2 + 1;
+
+    for (SizeType i = 0u; i < count; ++i)
+    {
+        append_synthetic_string(text, next_random(&seed) % distinct_count);
+    }
+
+    return text;
+}
+
+static void fill_list(StringList* list, const std::vector<CharType>& text)
+{
+    string_list_init(list);
+
+    for (cString position = text.data(); position != text.data() + text.size(); position += strlen(position) + 1)
+    {
+        string_list_add(list, position);
+    }
+}
+
+// Sorted with std::sort, string_list_sort is quadratic and itself one of the measured operations
+static void sorted_clone(StringList list, StringList* result)
+{
+    SizeType size = 0u;
+    string_list_clone(list, result);
+    string_list_size(*result, &size);
+
+    std::sort(*result, *result + size, [](cString left, cString right)
+    {
+        return strcmp(left, right) < 0;
+    });
+}
+
+static void prepare_nothing(Workload&, OperationState&)
+{
+}
+
+static void prepare_clone(Workload& workload, OperationState& state)
+{
+    string_list_clone(workload.source, &state.first);
+}
+
+static void prepare_filled(Workload& workload, OperationState& state)
+{
+    fill_list(&state.first, workload.text);
+}
+
+// Sorted operands take the merge path of the set operations, unsorted ones the hash set
+static void prepare_sorted_operands(Workload& workload, OperationState& state)
+{
+    string_list_clone(workload.sorted, &state.first);
+    string_list_clone(workload.other_sorted, &state.second);
+}
+
+static void prepare_unsorted_operands(Workload& workload, OperationState& state)
+{
+    string_list_clone(workload.source, &state.first);
+    string_list_clone(workload.other, &state.second);
+}
+
+static void prepare_compressed(Workload& workload, OperationState& state)
+{
+    compressed_string_list_build(workload.sorted, COMPRESSED_BLOCK_SIZE, &state.compressed);
+}
+
+static void prepare_null_device(Workload&, OperationState& state)
+{
+#ifdef _WIN32
+    state.fd = _open("NUL", _O_WRONLY | _O_BINARY);
+#else
+    state.fd = open("/dev/null", O_WRONLY);
+#endif
+}
+
+static void prepare_split_buffer(Workload& workload, OperationState& state)
+{
+    state.buffer = (mString)malloc(workload.text.size());
+    memcpy(state.buffer, workload.text.data(), workload.text.size());
+
+    for (SizeType i = 0u; i < workload.text.size(); ++i)
+    {
+        state.buffer[i] = state.buffer[i] == '\0' ? '\n' : state.buffer[i];
+    }
+}
+
+static ErrorCode run_lookups(Workload& workload, StringList list)
+{
+    SizeType index = 0u;
+
+    for (SizeType i = 0u; i < LINEAR_LOOKUP_COUNT; ++i)
+    {
+        string_list_index_of(list, workload.source[workload.lookups[i]], &index);
+    }
+
+    return string_list_index_of(list, "-missing-", &index);
+}
+
+static ErrorCode run_removals(Workload& workload, OperationState& state)
+{
+    for (SizeType i = 0u; i < LINEAR_LOOKUP_COUNT; ++i)
+    {
+        string_list_remove(state.first, workload.source[workload.lookups[i]]);
+    }
+
+    return ErrorCode::Success;
+}
+
+static ErrorCode run_compact_steps(Workload&, OperationState& state)
+{
+    StringListCompaction compaction = {};
+    SizeType reclaimed_bytes = 0u;
+    bool finished = false;
+    ErrorCode result_code = ErrorCode::Success;
+
+    while (!finished && result_code == ErrorCode::Success)
+    {
+        result_code = string_list_compact_step(&state.first, &compaction, COMPACTION_STEP_BUDGET_US, &reclaimed_bytes, &finished);
+    }
+
+    return result_code;
+}
+
+static ErrorCode run_compressed_scan(Workload& workload, OperationState& state)
+{
+    CharType buffer[MAX_STRING_LENGTH + 1];
+    SizeType length = 0u;
+
+    for (SizeType i = 0u; i < workload.count; ++i)
+    {
+        compressed_string_list_get(state.compressed, i, buffer, sizeof(buffer), &length);
+    }
+
+    return ErrorCode::Success;
+}
+
+static ErrorCode run_compressed_lookups(Workload& workload, OperationState& state)
+{
+    SizeType index = 0u;
+
+    for (SizeType i = 0u; i < BINARY_LOOKUP_COUNT; ++i)
+    {
+        compressed_string_list_index_of(state.compressed, workload.sorted[workload.lookups[i]], &index);
+    }
+
+    return ErrorCode::Success;
+}
+
+static const Operation operations[] =
+{
+    { "add", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { fill_list(&state.first, workload.text); return ErrorCode::Success; } },
+    { "destroy", UNLIMITED_COUNT, prepare_filled, [](Workload&, OperationState& state) { return string_list_destroy(&state.first); } },
+    { "size", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState&) { SizeType size = 0u; return string_list_size(workload.source, &size); } },
+    { "is_empty", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState&) { bool empty = false; return string_list_is_empty(workload.source, &empty); } },
+    { "index_of", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState&) { return run_lookups(workload, workload.source); } },
+    { "remove", UNLIMITED_COUNT, prepare_clone, run_removals },
+    { "clone", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { return string_list_clone(workload.source, &state.first); } },
+    { "remove_duplicates", QUADRATIC_MAX_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_remove_duplicates(&state.first); } },
+    // Strings are edited in place, the replacement must not be longer than what it replaces
+    { "replace_in_strings", UNLIMITED_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_replace_in_strings(state.first, "ab", "x"); } },
+    { "sort", QUADRATIC_MAX_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_sort(state.first); } },
+    { "partial_sort", UNLIMITED_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_partial_sort(state.first, PARTIAL_SORT_COUNT); } },
+    { "partial_sort_descending", UNLIMITED_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_partial_sort_descending(state.first, PARTIAL_SORT_COUNT); } },
+    { "nth_element", UNLIMITED_COUNT, prepare_clone, [](Workload& workload, OperationState& state) { return string_list_nth_element(state.first, workload.count / 2); } },
+    { "sort_by_case_insensitive", UNLIMITED_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_sort_by(state.first, string_key_case_insensitive); } },
+    { "sort_by_natural", UNLIMITED_COUNT, prepare_clone, [](Workload&, OperationState& state) { return string_list_sort_by(state.first, string_key_natural); } },
+    { "join", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { return string_list_join(workload.source, "\n", &state.buffer); } },
+    { "write_fd", UNLIMITED_COUNT, prepare_null_device, [](Workload& workload, OperationState& state) { return string_list_write_fd(workload.source, state.fd, "\n"); } },
+    { "union_sorted", UNLIMITED_COUNT, prepare_sorted_operands, [](Workload&, OperationState& state) { return string_list_union(&state.first, &state.second, &state.result); } },
+    { "intersection_sorted", UNLIMITED_COUNT, prepare_sorted_operands, [](Workload&, OperationState& state) { return string_list_intersection(&state.first, &state.second, &state.result); } },
+    { "difference_sorted", UNLIMITED_COUNT, prepare_sorted_operands, [](Workload&, OperationState& state) { return string_list_difference(&state.first, &state.second, &state.result); } },
+    { "union_unsorted", UNLIMITED_COUNT, prepare_unsorted_operands, [](Workload&, OperationState& state) { return string_list_union(&state.first, &state.second, &state.result); } },
+    { "intersection_unsorted", UNLIMITED_COUNT, prepare_unsorted_operands, [](Workload&, OperationState& state) { return string_list_intersection(&state.first, &state.second, &state.result); } },
+    { "difference_unsorted", UNLIMITED_COUNT, prepare_unsorted_operands, [](Workload&, OperationState& state) { return string_list_difference(&state.first, &state.second, &state.result); } },
+    { "from_split", UNLIMITED_COUNT, prepare_split_buffer, [](Workload& workload, OperationState& state) { return string_list_from_split(state.buffer, workload.text.size() - 1, '\n', &state.result); } },
+    { "count_occurrences", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { return string_list_count_occurrences(workload.source, &state.result, &state.counts, false); } },
+    { "count_occurrences_by_count", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { return string_list_count_occurrences(workload.source, &state.result, &state.counts, true); } },
+    { "compact", UNLIMITED_COUNT, prepare_filled, [](Workload&, OperationState& state) { SizeType reclaimed_bytes = 0u; return string_list_compact(&state.first, &reclaimed_bytes); } },
+    { "compact_step", UNLIMITED_COUNT, prepare_filled, run_compact_steps },
+    { "compressed_build", UNLIMITED_COUNT, prepare_nothing, [](Workload& workload, OperationState& state) { return compressed_string_list_build(workload.sorted, COMPRESSED_BLOCK_SIZE, &state.compressed); } },
+    { "compressed_get", UNLIMITED_COUNT, prepare_compressed, run_compressed_scan },
+    { "compressed_index_of", UNLIMITED_COUNT, prepare_compressed, run_compressed_lookups },
+};
+
+static void release_list(StringList* list)
+{
+    if (*list != nullptr)
+    {
+        string_list_destroy(list);
+    }
+}
+
+static void release_state(OperationState& state)
+{
+    release_list(&state.first);
+    release_list(&state.second);
+    release_list(&state.result);
+
+    if (state.compressed != nullptr)
+    {
+        compressed_string_list_destroy(&state.compressed);
+    }
+    free(state.buffer);
+    free(state.counts);
+
+    if (state.fd >= 0)
+    {
+#ifdef _WIN32
+        _close(state.fd);
+#else
+        close(state.fd);
+#endif
+    }
+}
+
+// Linux lets the peak be reset to the current RSS, so the growth of the peak during an
+// operation is what the operation itself needed. Elsewhere the peak of the whole run
+// so far cannot be lowered, and the growth is only a lower bound.
+static void reset_peak_rss()
+{
+    // Memory freed by earlier operations would otherwise be reused without showing up
+#if defined(_WIN32)
+    _heapmin();
+#elif defined(__GLIBC__)
+    malloc_trim(0u);
+#endif
+
+#ifdef __linux__
+    FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+
+    if (clear_refs != nullptr)
+    {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+#endif
+}
+
+static SizeType peak_rss_kib()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters = {};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+
+    return counters.PeakWorkingSetSize / 1024u;
+#else
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return (SizeType)usage.ru_maxrss / 1024u;
+#else
+    return (SizeType)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Fastest of repeat runs, every run starts from freshly prepared state. Quadratic
+// operations take seconds, there a single run is well above the noise.
+static bool measure(Workload& workload, const Operation& operation, SizeType repeat, Metrics* metrics)
+{
+    *metrics = Metrics { (SizeType)(-1), 0u, 0u };
+    repeat = operation.max_count == UNLIMITED_COUNT ? repeat : 1u;
+
+    for (SizeType i = 0u; i < repeat; ++i)
+    {
+        OperationState state = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, -1 };
+        operation.prepare(workload, state);
+        reset_peak_rss();
+
+        const SizeType rss_before_kib = peak_rss_kib();
+        const SizeType allocations_before = string_list_allocation_count;
+        const auto start = std::chrono::steady_clock::now();
+        const ErrorCode result_code = operation.run(workload, state);
+        const auto stop = std::chrono::steady_clock::now();
+        const SizeType allocations = string_list_allocation_count - allocations_before;
+        const SizeType time_us = (SizeType)std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+
+        metrics->time_us = std::min(metrics->time_us, time_us);
+        metrics->allocations = std::max(metrics->allocations, allocations);
+        const SizeType rss_after_kib = peak_rss_kib();
+        const SizeType rss_delta_kib = rss_after_kib > rss_before_kib ? rss_after_kib - rss_before_kib : 0u;
+
+        metrics->peak_rss_delta_kib = std::max(metrics->peak_rss_delta_kib, rss_delta_kib);
+        release_state(state);
+
+        if (result_code != ErrorCode::Success)
+        {
+            fprintf(stderr, "%s failed with error %d\n", operation.name, (int)result_code);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static Workload make_workload(SizeType count, unsigned long long seed)
+{
+    Workload workload = {};
+    workload.count = count;
+    workload.text = generate_text(count, seed);
+    fill_list(&workload.source, workload.text);
+    sorted_clone(workload.source, &workload.sorted);
+
+    std::vector<CharType> other_text = generate_text(count, seed + 1);
+    fill_list(&workload.other, other_text);
+    sorted_clone(workload.other, &workload.other_sorted);
+
+    unsigned long long state = seed;
+
+    for (SizeType i = 0u; i < std::max(LINEAR_LOOKUP_COUNT, BINARY_LOOKUP_COUNT); ++i)
+    {
+        workload.lookups.push_back(next_random(&state) % count);
+    }
+
+    return workload;
+}
+
+static void release_workload(Workload& workload)
+{
+    release_list(&workload.source);
+    release_list(&workload.sorted);
+    release_list(&workload.other);
+    release_list(&workload.other_sorted);
+}
+
+typedef std::map<std::pair<SizeType, std::string>, Metrics> Results;
+
+// Lines of "count operation time_us allocations peak_rss_delta_kib" after a "seed N" line,
+// '#' starts a comment
+static bool read_baseline(const char* path, unsigned long long* seed, Results* baseline)
+{
+    FILE* file = fopen(path, "r");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    char line[256];
+
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        unsigned long long count = 0u, time_us = 0u, allocations = 0u, peak_rss_delta_kib = 0u;
+        char name[128];
+
+        if (line[0] == '#' || sscanf(line, "seed %llu", seed) == 1)
+        {
+            continue;
+        }
+
+        if (sscanf(line, "%llu %127s %llu %llu %llu", &count, name, &time_us, &allocations, &peak_rss_delta_kib) == 5)
+        {
+            (*baseline)[std::make_pair((SizeType)count, std::string(name))] = Metrics { (SizeType)time_us, (SizeType)allocations, (SizeType)peak_rss_delta_kib };
+        }
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static bool write_baseline(const char* path, unsigned long long seed, const Results& results)
+{
+    FILE* file = fopen(path, "w");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    fprintf(file, "# count operation time_us allocations peak_rss_delta_kib\n");
+    fprintf(file, "seed %llu\n", seed);
+
+    for (const auto& result : results)
+    {
+        fprintf(file, "%llu %s %llu %llu %llu\n", (unsigned long long)result.first.first, result.first.second.c_str(),
+            (unsigned long long)result.second.time_us, (unsigned long long)result.second.allocations, (unsigned long long)result.second.peak_rss_delta_kib);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static bool exceeds(SizeType value, SizeType baseline_value, double threshold_percent)
+{
+    return (double)value > (double)baseline_value * (1.0 + threshold_percent / 100.0);
+}
+
+// A result without a baseline entry fails as well, unless a new baseline is being recorded
+static SizeType count_regressions(const Results& results, const Results& baseline, double threshold_percent, double time_threshold_percent, SizeType time_floor_us, SizeType rss_slack_kib, bool recording)
+{
+    SizeType regressions = 0u;
+
+    for (const auto& result : results)
+    {
+        const auto found = baseline.find(result.first);
+        const char* name = result.first.second.c_str();
+
+        if (found == baseline.end())
+        {
+            printf("%s %s: %llu strings not in the baseline\n", recording ? "NEW" : "MISSING", name, (unsigned long long)result.first.first);
+            regressions += recording ? 0u : 1u;
+            continue;
+        }
+
+        const Metrics& current = result.second;
+        const Metrics& expected = found->second;
+
+        // Timings below the floor are mostly noise
+        const bool compare_time = time_threshold_percent != TIME_NOT_COMPARED && expected.time_us >= time_floor_us;
+
+        if (compare_time && exceeds(current.time_us, expected.time_us, time_threshold_percent))
+        {
+            printf("REGRESSION %s: %llu us, baseline %llu us\n", name, (unsigned long long)current.time_us, (unsigned long long)expected.time_us);
+            ++regressions;
+        }
+
+        if (exceeds(current.allocations, expected.allocations, threshold_percent))
+        {
+            printf("REGRESSION %s: %llu allocations, baseline %llu\n", name, (unsigned long long)current.allocations, (unsigned long long)expected.allocations);
+            ++regressions;
+        }
+
+        // RSS moves in pages and depends on what the allocator kept from earlier operations
+        if (current.peak_rss_delta_kib > expected.peak_rss_delta_kib + rss_slack_kib &&
+            exceeds(current.peak_rss_delta_kib, expected.peak_rss_delta_kib, threshold_percent))
+        {
+            printf("REGRESSION %s: %llu KiB RSS growth, baseline %llu KiB\n", name, (unsigned long long)current.peak_rss_delta_kib, (unsigned long long)expected.peak_rss_delta_kib);
+            ++regressions;
+        }
+    }
+
+    return regressions;
+}
+
+static std::vector<SizeType> parse_counts(const char* text)
+{
+    std::vector<SizeType> counts;
+
+    for (char* end = nullptr; *text != '\0'; text = *end == ',' ? end + 1 : end)
+    {
+        counts.push_back((SizeType)strtoull(text, &end, 10));
+
+        if (end == text || counts.back() == 0u)
+        {
+            return std::vector<SizeType>();
+        }
+    }
+
+    return counts;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<SizeType> counts = { DEFAULT_COUNT };
+    unsigned long long seed = DEFAULT_SEED;
+    SizeType repeat = DEFAULT_REPEAT;
+    double threshold_percent = DEFAULT_THRESHOLD_PERCENT;
+    double time_threshold_percent = TIME_NOT_COMPARED;
+    SizeType time_floor_us = DEFAULT_TIME_FLOOR_US;
+    SizeType rss_slack_kib = DEFAULT_RSS_SLACK_KIB;
+    const char* baseline_path = nullptr;
+    const char* output_path = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        const char* value = argv[i + 1];
+
+        if (option == "--counts") counts = parse_counts(value);
+        else if (option == "--seed") seed = strtoull(value, nullptr, 10);
+        else if (option == "--repeat") repeat = (SizeType)strtoull(value, nullptr, 10);
+        else if (option == "--threshold") threshold_percent = atof(value);
+        else if (option == "--time-threshold") time_threshold_percent = atof(value);
+        else if (option == "--time-floor-us") time_floor_us = (SizeType)strtoull(value, nullptr, 10);
+        else if (option == "--rss-slack-kib") rss_slack_kib = (SizeType)strtoull(value, nullptr, 10);
+        else if (option == "--baseline") baseline_path = value;
+        else if (option == "--write-baseline") output_path = value;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (argc % 2 == 0 || counts.empty() || repeat == 0u || (time_threshold_percent < 0.0 && time_threshold_percent != TIME_NOT_COMPARED))
+    {
+        fprintf(stderr, "usage: %s [--counts N,...] [--seed N] [--repeat N] [--baseline FILE] [--threshold PERCENT] [--time-threshold PERCENT] [--time-floor-us N] [--rss-slack-kib N] [--write-baseline FILE]\n", argv[0]);
+        return 2;
+    }
+
+    Results results;
+    printf("%12s %-28s %12s %12s %18s\n", "count", "operation", "time_us", "allocations", "peak_rss_delta_kib");
+
+    for (SizeType count : counts)
+    {
+        Workload workload = make_workload(count, seed);
+
+        for (const Operation& operation : operations)
+        {
+            Metrics metrics;
+
+            if (count > operation.max_count)
+            {
+                printf("%12llu %-28s %12s\n", (unsigned long long)count, operation.name, "skipped");
+                continue;
+            }
+
+            if (!measure(workload, operation, repeat, &metrics))
+            {
+                release_workload(workload);
+                return 1;
+            }
+
+            results[std::make_pair(count, std::string(operation.name))] = metrics;
+            printf("%12llu %-28s %12llu %12llu %18llu\n", (unsigned long long)count, operation.name,
+                (unsigned long long)metrics.time_us, (unsigned long long)metrics.allocations, (unsigned long long)metrics.peak_rss_delta_kib);
+            fflush(stdout);
+        }
+
+        release_workload(workload);
+    }
+
+    SizeType regressions = 0u;
+
+    // Compared before writing, the new baseline may replace the old one
+    if (baseline_path != nullptr)
+    {
+        unsigned long long baseline_seed = seed;
+        Results baseline;
+
+        if (!read_baseline(baseline_path, &baseline_seed, &baseline))
+        {
+            fprintf(stderr, "cannot read %s\n", baseline_path);
+            return 2;
+        }
+
+        if (baseline_seed != seed)
+        {
+            fprintf(stderr, "the baseline was recorded with seed %llu\n", baseline_seed);
+            return 2;
+        }
+
+        regressions = count_regressions(results, baseline, threshold_percent, time_threshold_percent, time_floor_us, rss_slack_kib, output_path != nullptr);
+        printf("%llu failures, threshold %.1f%%", (unsigned long long)regressions, threshold_percent);
+
+        if (time_threshold_percent == TIME_NOT_COMPARED)
+        {
+            printf(", timings not compared\n");
+        }
+        else
+        {
+            printf(", time threshold %.1f%%\n", time_threshold_percent);
+        }
+    }
+
+    if (output_path != nullptr && !write_baseline(output_path, seed, results))
+    {
+        fprintf(stderr, "cannot write %s\n", output_path);
+        return 2;
+    }
+
+    return regressions == 0u ? 0 : 1;
+}
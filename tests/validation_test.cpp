@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../string_list.hpp"
+#include "../compressed_string_list.hpp"
+#include "../basic_string_list.hpp"
 
 class StringListValidationTest : public ::testing::Test
 {
@@ -96,3 +98,187 @@ TEST_F(StringListValidationTest, StringListSortNotNull)
     EXPECT_NE(string_list_sort(list)   , ErrorCode::NullPointerInput);
 }
 
+
+
+TEST_F(StringListValidationTest, StringListPartialSortNotNull)
+{
+    EXPECT_EQ(string_list_partial_sort(nullptr, 1u), ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_partial_sort(list, 1u)   , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_partial_sort_descending(nullptr, 1u), ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_partial_sort_descending(list, 1u)   , ErrorCode::NullPointerInput);
+}
+
+TEST_F(StringListValidationTest, StringListNthElementNotNull)
+{
+    EXPECT_EQ(string_list_nth_element(nullptr, 0u), ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_nth_element(list, 0u)   , ErrorCode::NullPointerInput);
+}
+
+TEST_F(StringListValidationTest, StringListSortByNotNull)
+{
+    EXPECT_EQ(string_list_sort_by(nullptr, nullptr)                    , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_sort_by(list, nullptr)                       , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_sort_by(nullptr, string_key_natural)         , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_sort_by(list, string_key_case_insensitive)   , ErrorCode::NullPointerInput);
+}
+
+TEST_F(StringListValidationTest, StringListJoinNotNull)
+{
+    mString joined = nullptr;
+    EXPECT_EQ(string_list_join(nullptr, nullptr, nullptr), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_join(nullptr, ",", &joined)    , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_join(list, nullptr, &joined)   , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_join(list, ",", nullptr)       , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_join(list, ",", &joined)       , ErrorCode::NullPointerInput);
+
+    free(joined);
+}
+
+TEST_F(StringListValidationTest, StringListWriteFdNotNull)
+{
+    EXPECT_EQ(string_list_write_fd(nullptr, 1, ",")   , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_write_fd(list, 1, nullptr)   , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_write_fd(list, 1, ",")       , ErrorCode::NullPointerInput);
+}
+
+TEST(StringListValidationSplitTest, StringListFromSplitNotNull)
+{
+    StringList list = nullptr;
+    EXPECT_EQ(string_list_from_split(nullptr, 0u, ',', nullptr), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_from_split(nullptr, 0u, ',', &list)  , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_from_split("a,b", 3u, ',', nullptr) , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_from_split("a,b", 3u, ',', &list)    , ErrorCode::NullPointerInput);
+
+    string_list_destroy(&list);
+}
+
+TEST_F(StringListValidationTest, StringListCountOccurrencesNotNull)
+{
+    StringList unique = nullptr;
+    SizeType* counts = nullptr;
+    EXPECT_EQ(string_list_count_occurrences(nullptr, nullptr, nullptr, false), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_count_occurrences(nullptr, &unique, &counts, false), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_count_occurrences(list, nullptr, &counts, false)   , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_count_occurrences(list, &unique, nullptr, false)   , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_count_occurrences(list, &unique, &counts, true)    , ErrorCode::NullPointerInput);
+
+    free(counts);
+    string_list_destroy(&unique);
+}
+
+TEST_F(StringListValidationTest, StringListCloneNotNull)
+{
+    StringList clone = nullptr;
+    EXPECT_EQ(string_list_clone(nullptr, nullptr), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_clone(list   , nullptr), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_clone(nullptr, &clone) , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_clone(list   , &clone) , ErrorCode::NullPointerInput);
+
+    string_list_destroy(&clone);
+}
+
+TEST_F(StringListValidationTest, StringListCompactNotNull)
+{
+    SizeType reclaimed_bytes;
+    EXPECT_EQ(string_list_compact(nullptr, nullptr)         , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_compact(&list, nullptr)           , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_compact(nullptr, &reclaimed_bytes), ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_compact(&list, &reclaimed_bytes)  , ErrorCode::NullPointerInput);
+}
+
+TEST_F(StringListValidationTest, StringListCompactStepNotNull)
+{
+    StringListCompaction compaction {};
+    SizeType reclaimed_bytes;
+    bool finished;
+    EXPECT_EQ(string_list_compact_step(nullptr, &compaction, 0u, &reclaimed_bytes, &finished), ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_compact_step(&list, nullptr, 0u, &reclaimed_bytes, &finished)     , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_compact_step(&list, &compaction, 0u, nullptr, &finished)          , ErrorCode::NullPointerInput);
+    EXPECT_EQ(string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, nullptr)   , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_compact_step(&list, &compaction, 0u, &reclaimed_bytes, &finished) , ErrorCode::NullPointerInput);
+    string_list_compact_abort(&compaction);
+}
+
+TEST(StringListValidationCompactTest, StringListCompactAbortNotNull)
+{
+    StringListCompaction compaction {};
+    EXPECT_EQ(string_list_compact_abort(nullptr)     , ErrorCode::NullPointerInput);
+    EXPECT_NE(string_list_compact_abort(&compaction) , ErrorCode::NullPointerInput);
+}
+
+TEST(StringListValidationSetOperationsTest, StringListSetOperationsNotNull)
+{
+    using SetOperationFunction = ErrorCode(*)(StringList*, StringList*, StringList*);
+    const SetOperationFunction operations[] { string_list_union, string_list_intersection, string_list_difference };
+
+    for (SetOperationFunction operation : operations)
+    {
+        StringList first = nullptr;
+        StringList second = nullptr;
+        StringList result = nullptr;
+
+        EXPECT_EQ(operation(&first, &second, &result) , ErrorCode::NullPointerInput);
+        string_list_init(&first);
+        EXPECT_EQ(operation(&first, &second, &result) , ErrorCode::NullPointerInput);
+        string_list_init(&second);
+        EXPECT_EQ(operation(nullptr, &second, &result), ErrorCode::NullPointerInput);
+        EXPECT_EQ(operation(&first, nullptr, &result) , ErrorCode::NullPointerInput);
+        EXPECT_EQ(operation(&first, &second, nullptr) , ErrorCode::NullPointerInput);
+        EXPECT_NE(operation(&first, &second, &result) , ErrorCode::NullPointerInput);
+
+        string_list_destroy(&result);
+    }
+}
+
+TEST_F(StringListValidationTest, CompressedStringListNotNull)
+{
+    CompressedStringList compressed = nullptr;
+    EXPECT_EQ(compressed_string_list_build(nullptr, 16u, &compressed), ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_build(list, 16u, nullptr)       , ErrorCode::NullPointerInput);
+    EXPECT_NE(compressed_string_list_build(list, 16u, &compressed)   , ErrorCode::NullPointerInput);
+
+    SizeType result;
+    CharType buffer[8];
+    EXPECT_EQ(compressed_string_list_size(nullptr, &result)                     , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_size(compressed, nullptr)                  , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_storage_bytes(nullptr, &result)            , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_storage_bytes(compressed, nullptr)         , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_get(nullptr, 0u, buffer, 8u, &result)      , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_get(compressed, 0u, nullptr, 8u, &result)  , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_get(compressed, 0u, buffer, 8u, nullptr)   , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_index_of(nullptr, "abc", &result)          , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_index_of(compressed, nullptr, &result)     , ErrorCode::NullPointerInput);
+    EXPECT_EQ(compressed_string_list_index_of(compressed, "abc", nullptr)       , ErrorCode::NullPointerInput);
+    EXPECT_NE(compressed_string_list_index_of(compressed, "abc", &result)       , ErrorCode::NullPointerInput);
+
+    EXPECT_EQ(compressed_string_list_destroy(nullptr)     , ErrorCode::NullPointerInput);
+    EXPECT_NE(compressed_string_list_destroy(&compressed) , ErrorCode::NullPointerInput);
+}
+TEST(BasicStringListValidationTest, NotNull)
+{
+    BasicStringList<> uninitialized;
+    EXPECT_EQ(uninitialized.add("abc")    , ErrorCode::NullPointerInput);
+    EXPECT_EQ(uninitialized.remove("abc") , ErrorCode::NullPointerInput);
+    EXPECT_EQ(uninitialized.destroy()     , ErrorCode::Success);
+
+    BasicStringList<> list;
+    list.init();
+    EXPECT_EQ(list.add(nullptr)    , ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.remove(nullptr) , ErrorCode::NullPointerInput);
+    EXPECT_NE(list.add("abc")      , ErrorCode::NullPointerInput);
+    EXPECT_NE(list.remove("abc")   , ErrorCode::NullPointerInput);
+
+    EXPECT_EQ(uninitialized.replace_in_strings("a", "b") , ErrorCode::NullPointerInput);
+    EXPECT_EQ(uninitialized.remove_duplicates()          , ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.replace_in_strings(nullptr, "b")      , ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.replace_in_strings("a", nullptr)      , ErrorCode::NullPointerInput);
+    EXPECT_NE(list.replace_in_strings("a", "b")          , ErrorCode::NullPointerInput);
+    EXPECT_NE(list.remove_duplicates()                   , ErrorCode::NullPointerInput);
+
+    mString joined = nullptr;
+    EXPECT_EQ(uninitialized.join(",", &joined) , ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.join(nullptr, &joined)      , ErrorCode::NullPointerInput);
+    EXPECT_EQ(list.join(",", nullptr)          , ErrorCode::NullPointerInput);
+    EXPECT_NE(list.join(",", &joined)          , ErrorCode::NullPointerInput);
+    free(joined);
+}